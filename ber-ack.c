@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Aggregated sequence acknowledgments of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-ack.h"
+
+static uint8_t uplink_cells;
+
+/*---------------------------------------------------------------------------*/
+static void
+put_le32(uint8_t *p, uint32_t v)
+{
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_entry(uint8_t *p, struct ber_node *node)
+{
+  p[0] = node->id >> 8;
+  p[1] = node->id;
+  put_le32(&p[2], node->seq.last_seq);
+  put_le32(&p[6], node->window);
+  node->ack_pending = 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_ack_set_cells(uint8_t cells)
+{
+  uplink_cells = cells;
+}
+/*---------------------------------------------------------------------------*/
+size_t
+ber_ack_build_node(uint8_t *buf, size_t size, struct ber_node *node)
+{
+  if(size < BER_ACK_HEADER_SIZE + BER_ACK_ENTRY_SIZE) {
+    return 0;
+  }
+
+  buf[0] = BER_ACK_MAGIC;
+  buf[1] = 1;
+  buf[2] = uplink_cells;
+  put_entry(&buf[BER_ACK_HEADER_SIZE], node);
+  return BER_ACK_HEADER_SIZE + BER_ACK_ENTRY_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+size_t
+ber_ack_build(uint8_t *buf, size_t size, uint8_t *index)
+{
+  size_t len = BER_ACK_HEADER_SIZE;
+  uint8_t count = 0;
+  struct ber_node *n;
+
+  if(size < BER_ACK_HEADER_SIZE + BER_ACK_ENTRY_SIZE) {
+    *index = BER_NODE_TABLE_SIZE;
+    return 0;
+  }
+
+  for(; *index < BER_NODE_TABLE_SIZE &&
+      len + BER_ACK_ENTRY_SIZE <= size; (*index)++) {
+    n = ber_node_get(*index);
+    if(n != NULL && n->ack_pending) {
+      put_entry(&buf[len], n);
+      len += BER_ACK_ENTRY_SIZE;
+      count++;
+    }
+  }
+
+  if(count == 0) {
+    return 0;
+  }
+  buf[0] = BER_ACK_MAGIC;
+  buf[1] = count;
+  buf[2] = uplink_cells;
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Aggregated sequence acknowledgments of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Instead of one ACK per datagram, the BER periodically sends each
+ *         node that was heard from one entry covering the last 32
+ *         package_numbers as a bitmap, taken from the replay window of the
+ *         node table (ber-node.h). Several entries can share one link-local
+ *         broadcast. An ACK datagram is laid out as:
+ *
+ *         | offset     | size | content                                  |
+ *         |------------|------|------------------------------------------|
+ *         | 0          | 1    | BER_ACK_MAGIC                            |
+ *         | 1          | 1    | number of entries N                      |
+ *         | 2          | 1    | root uplink cells, 0 if not advertised   |
+ *         | 3 + 10 * i | 2    | node ID, big-endian (BER_NODE_ID)        |
+ *         | 5 + 10 * i | 4    | highest package_number seen, LE          |
+ *         | 9 + 10 * i | 4    | window, LE; bit b set: seq - b received  |
+ *
+ *         A node keeps its unacknowledged records and, for its own entry,
+ *         resends those inside the window whose bit is clear. Records newer
+ *         than the acknowledged package_number are still in flight and wait
+ *         for the next ACK; records that fell out of the window unacked are
+ *         given up on.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_ACK_H_
+#define BER_ACK_H_
+
+#include "ber-conf.h"
+#include "ber-node.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Values of BER_CONF_ACK_MODE */
+#define BER_ACK_NONE       0 /* No application-level ACKs */
+#define BER_ACK_PER_PACKET 1 /* Legacy 4-byte ACK for every datagram */
+#define BER_ACK_UNICAST    2 /* One aggregated entry per node, unicast */
+#define BER_ACK_BROADCAST  3 /* Entries of many nodes per link-local broadcast */
+
+#define BER_ACK_MAGIC       0xAC
+#define BER_ACK_HEADER_SIZE 3
+#define BER_ACK_ENTRY_SIZE  10
+
+/* Entries per broadcast; the default keeps it within one 802.15.4 frame */
+#ifdef BER_ACK_CONF_MAX_ENTRIES
+#define BER_ACK_MAX_ENTRIES BER_ACK_CONF_MAX_ENTRIES
+#else
+#define BER_ACK_MAX_ENTRIES 6
+#endif
+
+#define BER_ACK_MAX_SIZE \
+  (BER_ACK_HEADER_SIZE + BER_ACK_MAX_ENTRIES * BER_ACK_ENTRY_SIZE)
+
+/**
+ * \brief Set the uplink cell count carried in the ACK header
+ * \param cells Cells the root listens on (ber-orchestra.h), 0 for none
+ */
+void ber_ack_set_cells(uint8_t cells);
+
+/**
+ * \brief Build the ACK of a single node and clear its pending flag
+ * \param buf Output buffer
+ * \param size Size of \p buf, at least BER_ACK_HEADER_SIZE + BER_ACK_ENTRY_SIZE
+ * \param node The node entry
+ * \return Number of bytes written, or 0 if \p buf is too small
+ */
+size_t ber_ack_build_node(uint8_t *buf, size_t size, struct ber_node *node);
+
+/**
+ * \brief Build an ACK covering as many pending nodes as fit
+ * \param buf Output buffer
+ * \param size Size of \p buf
+ * \param index Node table index to start from, advanced past the last
+ *        node added; BER_NODE_TABLE_SIZE once the table is exhausted
+ * \return Number of bytes written, or 0 if no node was pending
+ */
+size_t ber_ack_build(uint8_t *buf, size_t size, uint8_t *index);
+
+#endif /* BER_ACK_H_ */
+
+/** @} */
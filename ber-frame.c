@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Binary UART framing for the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-frame.h"
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+uint16_t
+ber_frame_crc16(const uint8_t *data, size_t len)
+{
+  uint16_t acc = 0;
+
+  while(len-- > 0) {
+    acc ^= *data++;
+    acc = (acc >> 8) | (acc << 8);
+    acc ^= (acc & 0xff00) << 4;
+    acc ^= (acc >> 8) >> 4;
+    acc ^= (acc & 0xff00) >> 5;
+  }
+  return acc;
+}
+/*---------------------------------------------------------------------------*/
+static size_t
+cobs_encode(const uint8_t *in, size_t len, uint8_t *out)
+{
+  size_t code_index = 0;
+  size_t w = 1;
+  uint8_t code = 1;
+
+  for(size_t r = 0; r < len; r++) {
+    if(in[r] == 0) {
+      out[code_index] = code;
+      code = 1;
+      code_index = w++;
+    } else {
+      out[w++] = in[r];
+      if(++code == 0xff) {
+        out[code_index] = code;
+        code = 1;
+        code_index = w++;
+      }
+    }
+  }
+  out[code_index] = code;
+  return w;
+}
+/*---------------------------------------------------------------------------*/
+static int
+cobs_decode(const uint8_t *in, size_t len, uint8_t *out, size_t out_size)
+{
+  size_t r = 0;
+  size_t w = 0;
+
+  while(r < len) {
+    uint8_t code = in[r++];
+    if(code == 0) {
+      return -1;
+    }
+    for(uint8_t i = 1; i < code; i++) {
+      if(r >= len || w >= out_size) {
+        return -1;
+      }
+      out[w++] = in[r++];
+    }
+    if(code != 0xff && r < len) {
+      if(w >= out_size) {
+        return -1;
+      }
+      out[w++] = 0;
+    }
+  }
+  return (int)w;
+}
+/*---------------------------------------------------------------------------*/
+static size_t
+encode(uint8_t *out, size_t out_size, uint8_t version, uint8_t type,
+       const uint8_t *origin, uint8_t origin_len,
+       const uint8_t *payload, uint16_t len, const uint64_t *asn)
+{
+  uint8_t raw[BER_FRAME_MAX_RAW_SIZE];
+  size_t raw_len;
+  size_t n;
+  uint16_t crc;
+  uint16_t total = len + (asn != NULL ? BER_FRAME_ASN_SIZE : 0);
+
+  if(total > BER_FRAME_MAX_PAYLOAD || out_size < BER_FRAME_MAX_ENCODED_SIZE) {
+    return 0;
+  }
+
+  raw[0] = version | (asn != NULL ? BER_FRAME_VERSION_ASN : 0);
+  raw[1] = type;
+  raw[2] = (uint8_t)total;
+  memcpy(&raw[3], origin, origin_len);
+  raw_len = 3 + origin_len;
+  if(len > 0) {
+    memcpy(&raw[raw_len], payload, len);
+  }
+  raw_len += len;
+  if(asn != NULL) {
+    for(uint8_t i = 0; i < BER_FRAME_ASN_SIZE; i++) {
+      raw[raw_len++] = (*asn >> (8 * i)) & 0xff;
+    }
+  }
+  crc = ber_frame_crc16(raw, raw_len);
+  raw[raw_len++] = crc & 0xff;
+  raw[raw_len++] = crc >> 8;
+
+  /* A leading delimiter flushes any log text the host saw before us */
+  out[0] = BER_FRAME_DELIMITER;
+  n = 1 + cobs_encode(raw, raw_len, &out[1]);
+  out[n++] = BER_FRAME_DELIMITER;
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+size_t
+ber_frame_encode(uint8_t *out, size_t out_size, uint8_t type,
+                 const uint8_t *addr, const uint8_t *payload, uint16_t len)
+{
+  return encode(out, out_size, BER_FRAME_VERSION, type,
+                addr, BER_FRAME_ADDR_SIZE, payload, len, NULL);
+}
+/*---------------------------------------------------------------------------*/
+size_t
+ber_frame_encode_node_id(uint8_t *out, size_t out_size, uint8_t type,
+                         uint16_t node_id, const uint8_t *payload,
+                         uint16_t len)
+{
+  uint8_t id[BER_FRAME_NODE_ID_SIZE] = { node_id >> 8, node_id & 0xff };
+
+  return encode(out, out_size, BER_FRAME_VERSION_NODE_ID, type,
+                id, sizeof(id), payload, len, NULL);
+}
+/*---------------------------------------------------------------------------*/
+size_t
+ber_frame_encode_asn(uint8_t *out, size_t out_size, uint8_t type,
+                     const uint8_t *addr, const uint8_t *payload,
+                     uint16_t len, uint64_t asn)
+{
+  return encode(out, out_size, BER_FRAME_VERSION, type,
+                addr, BER_FRAME_ADDR_SIZE, payload, len, &asn);
+}
+/*---------------------------------------------------------------------------*/
+size_t
+ber_frame_encode_node_id_asn(uint8_t *out, size_t out_size, uint8_t type,
+                             uint16_t node_id, const uint8_t *payload,
+                             uint16_t len, uint64_t asn)
+{
+  uint8_t id[BER_FRAME_NODE_ID_SIZE] = { node_id >> 8, node_id & 0xff };
+
+  return encode(out, out_size, BER_FRAME_VERSION_NODE_ID, type,
+                id, sizeof(id), payload, len, &asn);
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_frame_decode(const uint8_t *in, size_t in_len, struct ber_frame *frame)
+{
+  uint8_t raw[BER_FRAME_MAX_RAW_SIZE];
+  int raw_len;
+  int header;
+  uint16_t crc;
+  uint8_t version;
+
+  raw_len = cobs_decode(in, in_len, raw, sizeof(raw));
+  if(raw_len < 1) {
+    return -1;
+  }
+  version = raw[0] & ~BER_FRAME_VERSION_ASN;
+  if(version == BER_FRAME_VERSION) {
+    header = BER_FRAME_HEADER_SIZE;
+  } else if(version == BER_FRAME_VERSION_NODE_ID) {
+    header = BER_FRAME_NODE_ID_HEADER_SIZE;
+  } else {
+    return -1;
+  }
+  if(raw_len < header + BER_FRAME_CRC_SIZE ||
+     raw[2] != raw_len - header - BER_FRAME_CRC_SIZE) {
+    return -1;
+  }
+  raw_len -= BER_FRAME_CRC_SIZE;
+  crc = raw[raw_len] | (raw[raw_len + 1] << 8);
+  if(crc != ber_frame_crc16(raw, raw_len)) {
+    return -1;
+  }
+
+  frame->version = version;
+  frame->type = raw[1];
+  frame->len = raw[2];
+  frame->has_asn = (raw[0] & BER_FRAME_VERSION_ASN) != 0;
+  frame->asn = 0;
+  if(frame->has_asn) {
+    if(frame->len < BER_FRAME_ASN_SIZE) {
+      return -1;
+    }
+    frame->len -= BER_FRAME_ASN_SIZE;
+    for(uint8_t i = 0; i < BER_FRAME_ASN_SIZE; i++) {
+      frame->asn |= (uint64_t)raw[header + frame->len + i] << (8 * i);
+    }
+  }
+  if(header == BER_FRAME_HEADER_SIZE) {
+    memcpy(frame->addr, &raw[3], BER_FRAME_ADDR_SIZE);
+    frame->node_id = (frame->addr[14] << 8) | frame->addr[15];
+  } else {
+    memset(frame->addr, 0, BER_FRAME_ADDR_SIZE);
+    frame->node_id = (raw[3] << 8) | raw[4];
+  }
+  memcpy(frame->payload, &raw[header], frame->len);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Binary UART framing for the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Every record is sent as one COBS-encoded frame delimited by 0x00
+ *         bytes. Before encoding, a frame is laid out as:
+ *
+ *         | offset | size | content                                  |
+ *         |--------|------|------------------------------------------|
+ *         | 0      | 1    | frame version (BER_FRAME_VERSION)        |
+ *         | 1      | 1    | record type (BER_FRAME_TYPE_*)           |
+ *         | 2      | 1    | payload length N                         |
+ *         | 3      | 16   | sender IPv6 address                      |
+ *         | 19     | N    | payload, little-endian int32 fields      |
+ *         | 19 + N | 2    | CRC-16 of bytes [0, 19 + N), LSB first   |
+ *
+ *         Frames of version BER_FRAME_VERSION_NODE_ID carry the 2-byte node
+ *         ID (the last two address bytes, big-endian) instead of the
+ *         address, so the header shrinks to 5 bytes.
+ *
+ *         Records from nodes that sent only some of their fields (see
+ *         ber-wire.h) carry the presence bitmap after the fields, so their
+ *         payload is the format length plus the bitmap size.
+ *
+ *         A frame whose version has BER_FRAME_VERSION_ASN set ends its
+ *         payload with the time the record was received (ber-time.h), as
+ *         5 little-endian bytes. The payload length includes them.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_FRAME_H_
+#define BER_FRAME_H_
+
+#include "ber-conf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define BER_FRAME_VERSION        1
+#define BER_FRAME_VERSION_NODE_ID 2
+#define BER_FRAME_VERSION_ASN    0x10 /* Flag, the payload ends with the ASN */
+#define BER_FRAME_ASN_SIZE       5    /* A TSCH ASN is 40 bits */
+#define BER_FRAME_DELIMITER      0x00
+#define BER_FRAME_ADDR_SIZE      16
+#define BER_FRAME_NODE_ID_SIZE   2
+#define BER_FRAME_HEADER_SIZE    (3 + BER_FRAME_ADDR_SIZE)
+#define BER_FRAME_NODE_ID_HEADER_SIZE (3 + BER_FRAME_NODE_ID_SIZE)
+#define BER_FRAME_CRC_SIZE       2
+
+#ifdef BER_FRAME_CONF_MAX_PAYLOAD
+#define BER_FRAME_MAX_PAYLOAD BER_FRAME_CONF_MAX_PAYLOAD
+#else
+#define BER_FRAME_MAX_PAYLOAD 128
+#endif
+
+#define BER_FRAME_MAX_RAW_SIZE \
+  (BER_FRAME_HEADER_SIZE + BER_FRAME_MAX_PAYLOAD + BER_FRAME_CRC_SIZE)
+
+/* COBS adds one byte per 254 plus the leading code byte; we add 2 delimiters */
+#define BER_FRAME_MAX_ENCODED_SIZE \
+  (BER_FRAME_MAX_RAW_SIZE + BER_FRAME_MAX_RAW_SIZE / 254 + 1 + 2)
+
+/* Record types, one per datagram format the BER understands */
+#define BER_FRAME_TYPE_PING      1  /* 2 bytes, no fields */
+#define BER_FRAME_TYPE_CO2       2  /* 12 bytes, CO2 and air velocity */
+#define BER_FRAME_TYPE_LEGACY    3  /* 68 bytes, legacy SensorTag board */
+#define BER_FRAME_TYPE_IMF4D     4  /* 76 bytes, IMF4D base board */
+
+/* Records generated by the BER itself, never matched against datagrams */
+#define BER_FRAME_TYPE_INTERNAL   0x80
+#define BER_FRAME_TYPE_NODE_STATS 0x81 /* Per-node sequence counters */
+#define BER_FRAME_TYPE_NODE_ENERGY 0x82 /* Per-node energest duty cycles */
+#define BER_FRAME_TYPE_PROF       0x83 /* Stage histogram, node ID = stage */
+#define BER_FRAME_TYPE_STORED     0x84 /* Replayed from flash, see ber-store.h */
+#define BER_FRAME_TYPE_ANCHOR     0x85 /* Network time, node ID = time source */
+#define BER_FRAME_TYPE_SUMMARY    0x86 /* Window statistics, see ber-summary.h */
+
+/** \brief A decoded binary frame */
+struct ber_frame {
+  uint8_t version;    /* Without BER_FRAME_VERSION_ASN */
+  uint8_t type;
+  uint8_t len;        /* Without the ASN */
+  uint8_t has_asn;
+  uint64_t asn;
+  uint8_t addr[BER_FRAME_ADDR_SIZE];  /* All zero in node ID frames */
+  uint16_t node_id;
+  uint8_t payload[BER_FRAME_MAX_PAYLOAD];
+};
+
+/**
+ * \brief Compute the frame CRC (same polynomial and seed as Contiki's
+ *        crc16_data(), so either side may use its own implementation)
+ * \param data Bytes to checksum
+ * \param len Number of bytes
+ * \return The CRC-16 value
+ */
+uint16_t ber_frame_crc16(const uint8_t *data, size_t len);
+
+/**
+ * \brief Build a complete, delimited frame ready to be written to the UART
+ * \param out Output buffer, at least BER_FRAME_MAX_ENCODED_SIZE bytes
+ * \param out_size Size of \p out
+ * \param type One of BER_FRAME_TYPE_*
+ * \param addr 16-byte sender address
+ * \param payload Payload bytes, may be NULL if \p len is 0
+ * \param len Payload length, at most BER_FRAME_MAX_PAYLOAD
+ * \return Number of bytes written to \p out, or 0 on error
+ */
+size_t ber_frame_encode(uint8_t *out, size_t out_size, uint8_t type,
+                        const uint8_t *addr, const uint8_t *payload,
+                        uint16_t len);
+
+/**
+ * \brief Like ber_frame_encode(), but with the node ID in place of the address
+ * \param out Output buffer, at least BER_FRAME_MAX_ENCODED_SIZE bytes
+ * \param out_size Size of \p out
+ * \param type One of BER_FRAME_TYPE_*
+ * \param node_id Node ID of the sender
+ * \param payload Payload bytes, may be NULL if \p len is 0
+ * \param len Payload length, at most BER_FRAME_MAX_PAYLOAD
+ * \return Number of bytes written to \p out, or 0 on error
+ */
+size_t ber_frame_encode_node_id(uint8_t *out, size_t out_size, uint8_t type,
+                                uint16_t node_id, const uint8_t *payload,
+                                uint16_t len);
+
+/**
+ * \brief Like ber_frame_encode(), followed by the reception time
+ * \param out Output buffer, at least BER_FRAME_MAX_ENCODED_SIZE bytes
+ * \param out_size Size of \p out
+ * \param type One of BER_FRAME_TYPE_*
+ * \param addr 16-byte sender address
+ * \param payload Payload bytes, may be NULL if \p len is 0
+ * \param len Payload length, at most BER_FRAME_MAX_PAYLOAD -
+ *        BER_FRAME_ASN_SIZE
+ * \param asn Reception time in slots, see ber-time.h
+ * \return Number of bytes written to \p out, or 0 on error
+ */
+size_t ber_frame_encode_asn(uint8_t *out, size_t out_size, uint8_t type,
+                            const uint8_t *addr, const uint8_t *payload,
+                            uint16_t len, uint64_t asn);
+
+/**
+ * \brief Like ber_frame_encode_node_id(), followed by the reception time
+ * \param out Output buffer, at least BER_FRAME_MAX_ENCODED_SIZE bytes
+ * \param out_size Size of \p out
+ * \param type One of BER_FRAME_TYPE_*
+ * \param node_id Node ID of the sender
+ * \param payload Payload bytes, may be NULL if \p len is 0
+ * \param len Payload length, at most BER_FRAME_MAX_PAYLOAD -
+ *        BER_FRAME_ASN_SIZE
+ * \param asn Reception time in slots, see ber-time.h
+ * \return Number of bytes written to \p out, or 0 on error
+ */
+size_t ber_frame_encode_node_id_asn(uint8_t *out, size_t out_size,
+                                    uint8_t type, uint16_t node_id,
+                                    const uint8_t *payload, uint16_t len,
+                                    uint64_t asn);
+
+/**
+ * \brief Decode one frame from the bytes found between two delimiters
+ * \param in COBS-encoded bytes, without the delimiters
+ * \param in_len Number of bytes in \p in
+ * \param frame Filled in on success
+ * \return 0 on success, -1 if the frame is malformed or fails its CRC
+ */
+int ber_frame_decode(const uint8_t *in, size_t in_len, struct ber_frame *frame);
+
+#endif /* BER_FRAME_H_ */
+
+/** @} */
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Streaming JSON text writer for the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-json.h"
+#include <string.h>
+
+/* Digits of a uint32_t */
+#define MAX_DIGITS 10
+
+/*---------------------------------------------------------------------------*/
+void
+ber_json_init(struct ber_json *w, char *buf, size_t size)
+{
+  w->buf = buf;
+  w->size = size;
+  w->len = 0;
+  w->flushed = 0;
+  w->flush = NULL;
+  w->kind = NULL;
+  w->overflow = 0;
+  w->style = BER_JSON_PRETTY;
+  w->header = 0;
+  w->mute = 0;
+  w->members = 0;
+  buf[0] = '\0';
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_set_style(struct ber_json *w, uint8_t style, const char *kind,
+                   uint8_t header)
+{
+  w->style = style;
+  w->kind = kind;
+  w->header = style == BER_JSON_CSV && header;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_init_stream(struct ber_json *w, char *buf, size_t size,
+                     void (*flush)(const char *buf, size_t len))
+{
+  ber_json_init(w, buf, size);
+  w->flush = flush;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_flush(struct ber_json *w)
+{
+  if(w->flush != NULL && w->len > 0) {
+    w->flush(w->buf, w->len);
+    w->flushed += w->len;
+    w->len = 0;
+    w->buf[0] = '\0';
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+append(struct ber_json *w, const char *s, size_t n)
+{
+  size_t room;
+
+  if(w->overflow || w->mute) {
+    return;
+  }
+  /* Streaming: fill the buffer, hand it over, repeat */
+  while(w->flush != NULL && n >= (room = w->size - 1 - w->len)) {
+    memcpy(&w->buf[w->len], s, room);
+    w->len += room;
+    s += room;
+    n -= room;
+    ber_json_flush(w);
+  }
+  if(n >= w->size - w->len) {
+    w->overflow = 1;
+    return;
+  }
+  memcpy(&w->buf[w->len], s, n);
+  w->len += n;
+  w->buf[w->len] = '\0';
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_str(struct ber_json *w, const char *s)
+{
+  append(w, s, strlen(s));
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_char(struct ber_json *w, char c)
+{
+  append(w, &c, 1);
+}
+/*---------------------------------------------------------------------------*/
+/* Digits of v, at least min_digits of them, zero-padded on the left */
+static void
+append_digits(struct ber_json *w, uint32_t v, uint8_t min_digits)
+{
+  char digits[MAX_DIGITS];
+  uint8_t n = 0;
+
+  do {
+    digits[MAX_DIGITS - ++n] = '0' + v % 10;
+    v /= 10;
+  } while(v > 0);
+  while(n < min_digits && n < MAX_DIGITS) {
+    digits[MAX_DIGITS - ++n] = '0';
+  }
+  append(w, &digits[MAX_DIGITS - n], n);
+}
+/*---------------------------------------------------------------------------*/
+/* Magnitude of v, correct for INT32_MIN */
+static uint32_t
+magnitude(int32_t v)
+{
+  return v < 0 ? 0 - (uint32_t)v : (uint32_t)v;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_uint(struct ber_json *w, uint32_t v)
+{
+  append_digits(w, v, 1);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_uint64(struct ber_json *w, uint64_t v)
+{
+  /* Nine digits at a time keeps the formatting in 32 bits */
+  if(v > UINT32_MAX) {
+    ber_json_uint64(w, v / 1000000000);
+    append_digits(w, (uint32_t)(v % 1000000000), 9);
+    return;
+  }
+  append_digits(w, (uint32_t)v, 1);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_int(struct ber_json *w, int32_t v)
+{
+  if(v < 0) {
+    ber_json_char(w, '-');
+  }
+  append_digits(w, magnitude(v), 1);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_fixed(struct ber_json *w, int32_t v, uint8_t precision)
+{
+  static const uint32_t pow10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+    1000000000
+  };
+  uint32_t m = magnitude(v);
+
+  if(precision == 0 || precision >= sizeof(pow10) / sizeof(pow10[0])) {
+    ber_json_int(w, v);
+    return;
+  }
+  /* The sign goes on the whole value, so -5 at precision 2 is -0.05 */
+  if(v < 0) {
+    ber_json_char(w, '-');
+  }
+  append_digits(w, m / pow10[precision], 1);
+  ber_json_char(w, '.');
+  append_digits(w, m % pow10[precision], precision);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_split(struct ber_json *w, int32_t ipart, int32_t frac,
+               uint8_t precision)
+{
+  /* -0.5 arrives as 0 and -50, so either part may carry the sign */
+  if(ipart < 0 || frac < 0) {
+    ber_json_char(w, '-');
+  }
+  append_digits(w, magnitude(ipart), 1);
+  ber_json_char(w, '.');
+  append_digits(w, magnitude(frac), precision);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_key(struct ber_json *w, const char *key)
+{
+  ber_json_char(w, '"');
+  ber_json_str(w, key);
+  ber_json_str(w, "\":");
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_key_str(struct ber_json *w, const char *key, const char *value)
+{
+  ber_json_key(w, key);
+  ber_json_char(w, '"');
+  ber_json_str(w, value);
+  ber_json_char(w, '"');
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_object_begin(struct ber_json *w)
+{
+  w->mute = 0;
+  w->members = 0;
+  if(w->style != BER_JSON_CSV) {
+    ber_json_char(w, '{');
+  }
+  if(w->kind != NULL) {
+    if(w->style == BER_JSON_CSV) {
+      ber_json_str(w, w->header ? "#" : "");
+      ber_json_str(w, w->kind);
+      w->members++;
+    } else {
+      ber_json_member_str(w, "record", w->kind);
+    }
+  }
+  w->mute = w->header;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_member(struct ber_json *w, const char *key)
+{
+  w->mute = 0;
+  if(w->members++ > 0) {
+    ber_json_char(w, ',');
+  }
+  if(w->style == BER_JSON_PRETTY) {
+    ber_json_str(w, "\n    ");
+  }
+  if(w->style != BER_JSON_CSV) {
+    ber_json_key(w, key);
+  } else if(w->header) {
+    ber_json_str(w, key);
+  }
+  w->mute = w->header;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_member_str(struct ber_json *w, const char *key, const char *value)
+{
+  ber_json_member(w, key);
+  if(w->style == BER_JSON_CSV) {
+    ber_json_str(w, value);
+    return;
+  }
+  ber_json_char(w, '"');
+  ber_json_str(w, value);
+  ber_json_char(w, '"');
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_member_absent(struct ber_json *w, const char *key)
+{
+  if(w->style == BER_JSON_CSV) {
+    ber_json_member(w, key);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_json_object_end(struct ber_json *w)
+{
+  w->mute = 0;
+  if(w->style == BER_JSON_PRETTY) {
+    ber_json_str(w, "\n}");
+  } else if(w->style == BER_JSON_COMPACT) {
+    ber_json_char(w, '}');
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_json_result(const struct ber_json *w)
+{
+  return w->overflow ? -1 : (int)(w->flushed + w->len);
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Streaming JSON text writer for the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Appends text and numbers to a caller-supplied buffer, with no
+ *         printf and no varargs. Every append checks the remaining
+ *         capacity. A streaming writer hands the buffer to its flush
+ *         function whenever it fills up, so a small buffer can carry a
+ *         record of any length. A plain writer stops appending once
+ *         something does not fit and keeps the text NUL-terminated.
+ *
+ *         Objects written member by member (ber_json_object_begin(),
+ *         ber_json_member(), ber_json_object_end()) come out in one of
+ *         three styles: the pretty multi-line JSON of BER_OUTPUT_JSON,
+ *         compact single-line JSON, or CSV, where only the values are
+ *         written and an absent member leaves an empty cell. In a CSV
+ *         header row the member names take the place of the values, so
+ *         the same code writes the header and the rows in the same order.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_JSON_H_
+#define BER_JSON_H_
+
+#include "ber-conf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Object styles, see ber_json_set_style() */
+#define BER_JSON_PRETTY  0 /* One member per line, indented by four spaces */
+#define BER_JSON_COMPACT 1 /* The whole object on one line */
+#define BER_JSON_CSV     2 /* Comma-separated values, no names or quotes */
+
+/** \brief Writer state; the buffer belongs to the caller */
+struct ber_json {
+  char *buf;
+  size_t size;
+  size_t len;        /* Characters in buf, excluding the NUL */
+  size_t flushed;    /* Characters already passed to flush */
+  void (*flush)(const char *buf, size_t len);
+  const char *kind;  /* Leads each object, see ber_json_set_style() */
+  uint8_t overflow;  /* Set once an append did not fit */
+  uint8_t style;     /* BER_JSON_* */
+  uint8_t header;    /* CSV header row: names instead of values */
+  uint8_t mute;      /* Inside a header row, values are dropped */
+  uint8_t members;   /* Members of the current object so far */
+};
+
+/**
+ * \brief Start writing into a buffer
+ * \param w The writer
+ * \param buf Output buffer
+ * \param size Size of \p buf, at least 1
+ */
+void ber_json_init(struct ber_json *w, char *buf, size_t size);
+
+/**
+ * \brief Start a streaming writer
+ * \param w The writer
+ * \param buf Staging buffer
+ * \param size Size of \p buf, at least 2
+ * \param flush Called with the buffered text whenever \p buf is full, and
+ *        by ber_json_flush()
+ */
+void ber_json_init_stream(struct ber_json *w, char *buf, size_t size,
+                          void (*flush)(const char *buf, size_t len));
+
+/**
+ * \brief Choose how objects are written; a new writer is BER_JSON_PRETTY
+ * \param w The writer
+ * \param style One of BER_JSON_*
+ * \param kind Record kind written ahead of the members, as "record":"kind"
+ *        in JSON and as the first cell in CSV, or NULL for none
+ * \param header Non-zero for a CSV header row; its first cell is "#kind"
+ */
+void ber_json_set_style(struct ber_json *w, uint8_t style, const char *kind,
+                        uint8_t header);
+
+/**
+ * \brief Pass whatever is buffered to the flush function
+ */
+void ber_json_flush(struct ber_json *w);
+
+/**
+ * \brief Append a NUL-terminated string as-is
+ */
+void ber_json_str(struct ber_json *w, const char *s);
+
+/**
+ * \brief Append one character
+ */
+void ber_json_char(struct ber_json *w, char c);
+
+/**
+ * \brief Append an unsigned decimal integer
+ */
+void ber_json_uint(struct ber_json *w, uint32_t v);
+
+/**
+ * \brief Append an unsigned 64-bit decimal integer, such as a TSCH ASN
+ */
+void ber_json_uint64(struct ber_json *w, uint64_t v);
+
+/**
+ * \brief Append a signed decimal integer
+ */
+void ber_json_int(struct ber_json *w, int32_t v);
+
+/**
+ * \brief Append a fixed-point value, v / 10^precision ("-0.05" for -5, 2)
+ * \param w The writer
+ * \param v Scaled value
+ * \param precision Digits after the point, at most 9
+ */
+void ber_json_fixed(struct ber_json *w, int32_t v, uint8_t precision);
+
+/**
+ * \brief Append a value sent as an integer part and a fractional part
+ * \param w The writer
+ * \param ipart Integer part
+ * \param frac Fractional digits, zero-padded to \p precision
+ * \param precision Minimum number of fractional digits
+ *
+ * The value is negative if either part is.
+ */
+void ber_json_split(struct ber_json *w, int32_t ipart, int32_t frac,
+                    uint8_t precision);
+
+/**
+ * \brief Append a member with a string value, "key":"value"
+ */
+void ber_json_key_str(struct ber_json *w, const char *key, const char *value);
+
+/**
+ * \brief Append a member name, "key":, for the caller to add the value
+ */
+void ber_json_key(struct ber_json *w, const char *key);
+
+/**
+ * \brief Open an object in the current style
+ */
+void ber_json_object_begin(struct ber_json *w);
+
+/**
+ * \brief Start the next member of an object, for the caller to add the value
+ * \param w The writer
+ * \param key Member name
+ */
+void ber_json_member(struct ber_json *w, const char *key);
+
+/**
+ * \brief Append a member with a string value
+ *
+ *        The value is quoted in JSON and written as-is in CSV, so it must
+ *        not contain a comma.
+ */
+void ber_json_member_str(struct ber_json *w, const char *key,
+                         const char *value);
+
+/**
+ * \brief Account for a member without a value: an empty CSV cell, nothing
+ *        in JSON
+ */
+void ber_json_member_absent(struct ber_json *w, const char *key);
+
+/**
+ * \brief Close an object in the current style
+ */
+void ber_json_object_end(struct ber_json *w);
+
+/**
+ * \brief Result of the writer
+ * \return Number of characters written (flushed ones included), or -1 if
+ *         the text was truncated
+ */
+int ber_json_result(const struct ber_json *w);
+
+#endif /* BER_JSON_H_ */
+
+/** @} */
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Per-node state table of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-node.h"
+#include <stdio.h>
+#include <string.h>
+
+static struct ber_node nodes[BER_NODE_TABLE_SIZE];
+static uint32_t heard_counter;
+#if !BER_NODE_ADDR_CACHE
+/* Shared by all entries; its callers write one record at a time */
+static char addr_str[BER_NODE_ADDR_STR_SIZE];
+#endif
+
+/*---------------------------------------------------------------------------*/
+struct ber_node *
+ber_node_lookup(const uint8_t *addr)
+{
+  struct ber_node *oldest = &nodes[0];
+  struct ber_node *n;
+
+  heard_counter++;
+
+  for(n = nodes; n < &nodes[BER_NODE_TABLE_SIZE]; n++) {
+    if(n->in_use &&
+       memcmp(&n->addr[BER_NODE_IID_OFFSET], &addr[BER_NODE_IID_OFFSET],
+              sizeof(n->addr) - BER_NODE_IID_OFFSET) == 0) {
+      n->last_heard = heard_counter;
+      return n;
+    }
+    if(!n->in_use) {
+      oldest = n;
+    } else if(oldest->in_use &&
+              heard_counter - n->last_heard > heard_counter - oldest->last_heard) {
+      oldest = n;
+    }
+  }
+
+  memset(oldest, 0, sizeof(*oldest));
+  memcpy(oldest->addr, addr, sizeof(oldest->addr));
+#if BER_NODE_ADDR_CACHE
+  ber_node_addr_to_str(addr, oldest->addr_str);
+#endif
+  oldest->id = BER_NODE_ID(addr);
+  oldest->in_use = 1;
+  oldest->last_heard = heard_counter;
+  return oldest;
+}
+/*---------------------------------------------------------------------------*/
+struct ber_node *
+ber_node_find(const uint8_t *addr)
+{
+  struct ber_node *n;
+
+  for(n = nodes; n < &nodes[BER_NODE_TABLE_SIZE]; n++) {
+    if(n->in_use &&
+       memcmp(&n->addr[BER_NODE_IID_OFFSET], &addr[BER_NODE_IID_OFFSET],
+              sizeof(n->addr) - BER_NODE_IID_OFFSET) == 0) {
+      return n;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_node_seq_update(struct ber_node *node, uint32_t seq)
+{
+  struct ber_node_seq_stats *s = &node->seq;
+  int32_t diff = (int32_t)(seq - s->last_seq);
+
+  /* Duplicates too: the node retransmits when it missed our last ACK */
+  node->ack_pending = 1;
+
+  if(!node->has_seq || diff > BER_NODE_RESYNC_GAP ||
+     diff <= -BER_NODE_WINDOW_SIZE) {
+    /* First record, or the node restarted its numbering */
+    node->has_seq = 1;
+    node->window = 1;
+    s->last_seq = seq;
+    s->received++;
+    return BER_SEQ_NEW;
+  }
+
+  if(diff > 0) {
+    s->lost += diff - 1;
+    node->window = diff < BER_NODE_WINDOW_SIZE ? (node->window << diff) | 1 : 1;
+    s->last_seq = seq;
+    s->received++;
+    return BER_SEQ_NEW;
+  }
+
+  if(node->window & (1UL << -diff)) {
+    s->duplicates++;
+    return BER_SEQ_DUPLICATE;
+  }
+
+  /* A late record fills a gap we already counted as lost */
+  node->window |= 1UL << -diff;
+  if(s->lost > 0) {
+    s->lost--;
+  }
+  s->reordered++;
+  s->received++;
+  return BER_SEQ_NEW;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_node_seq_check(const struct ber_node *node, uint32_t seq)
+{
+  int32_t diff = (int32_t)(seq - node->seq.last_seq);
+
+  if(!node->has_seq || diff > 0 || diff <= -BER_NODE_WINDOW_SIZE) {
+    return BER_SEQ_NEW;
+  }
+  return node->window & (1UL << -diff) ? BER_SEQ_DUPLICATE : BER_SEQ_NEW;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_node_seq_forget(struct ber_node *node, uint32_t seq)
+{
+  struct ber_node_seq_stats *s = &node->seq;
+  int32_t diff = (int32_t)(seq - s->last_seq);
+
+  if(ber_node_seq_check(node, seq) != BER_SEQ_DUPLICATE) {
+    return;
+  }
+  node->window &= ~(1UL << -diff);
+  s->received--;
+  s->lost++;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_node_energy_update(struct ber_node *node, const uint32_t *values)
+{
+  struct ber_node_energy *e = &node->energy;
+
+  /* A retransmitted report carries the same period number */
+  if(node->has_energy &&
+     values[BER_ENERGEST_PERIOD_COUNT] == e->last_period) {
+    return BER_SEQ_DUPLICATE;
+  }
+
+  node->has_energy = 1;
+  e->cpu += values[BER_ENERGEST_CPU];
+  e->lpm += values[BER_ENERGEST_LPM];
+  e->deep_lpm += values[BER_ENERGEST_DEEP_LPM];
+  e->radio_tx += values[BER_ENERGEST_RADIO_TX];
+  e->radio_rx += values[BER_ENERGEST_RADIO_RX];
+  e->total += values[BER_ENERGEST_TOTAL];
+  e->seconds += values[BER_ENERGEST_PERIOD_TIME];
+  e->periods++;
+  e->last_period = values[BER_ENERGEST_PERIOD_COUNT];
+  return BER_SEQ_NEW;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_node_addr_to_str(const uint8_t *addr, char *buf)
+{
+  int zero_start = -1;
+  int zero_len = 0;
+  int i, j;
+  char *p = buf;
+
+  /* The longest run of two or more zero words becomes "::" */
+  for(i = 0; i < 8; i = j + 1) {
+    for(j = i; j < 8 && addr[2 * j] == 0 && addr[2 * j + 1] == 0; j++) {
+    }
+    if(j - i > zero_len && j - i > 1) {
+      zero_start = i;
+      zero_len = j - i;
+    }
+  }
+
+  for(i = 0; i < 8; i++) {
+    if(i == zero_start) {
+      *p++ = ':';
+      if(i == 0) {
+        *p++ = ':';
+      }
+      i += zero_len - 1;
+      continue;
+    }
+    p += sprintf(p, "%x", (addr[2 * i] << 8) | addr[2 * i + 1]);
+    if(i < 7) {
+      *p++ = ':';
+    }
+  }
+  *p = '\0';
+}
+/*---------------------------------------------------------------------------*/
+const char *
+ber_node_addr_str(const struct ber_node *node)
+{
+#if BER_NODE_ADDR_CACHE
+  return node->addr_str;
+#else
+  ber_node_addr_to_str(node->addr, addr_str);
+  return addr_str;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+struct ber_node *
+ber_node_get(uint8_t index)
+{
+  if(index >= BER_NODE_TABLE_SIZE || !nodes[index].in_use) {
+    return NULL;
+  }
+  return &nodes[index];
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_node_count(void)
+{
+  uint8_t count = 0;
+
+  for(uint8_t i = 0; i < BER_NODE_TABLE_SIZE; i++) {
+    count += nodes[i].in_use;
+  }
+  return count;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Per-node state table of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         One entry per sensor node, keyed by the interface identifier
+ *         (lower 64 bits) of its IPv6 address. The table is sized like the
+ *         RPL route table, since the root holds one route per node; when it
+ *         is full the least recently heard node is evicted.
+ *
+ *         Each entry tracks the last package_number and a 32-packet replay
+ *         window, so that duplicates from MAC retransmissions or RPL path
+ *         changes are dropped before any formatting work, and received,
+ *         duplicate, lost and out-of-order records are counted. The same
+ *         window is what the BER acknowledges back to the node. It also
+ *         accumulates the node's energest reports, keeps the reference
+ *         record for delta-coded datagrams (ber-wire.h), and caches the
+ *         printed address and short node ID so output paths do not format
+ *         the address for every record. With BER_NODE_CONF_ADDR_CACHE set to
+ *         0 the address text is formatted on demand instead, which saves 40
+ *         bytes of RAM per entry.
+ * @{
+ */
+#ifndef BER_NODE_H_
+#define BER_NODE_H_
+
+#include "ber-conf.h"
+#include "ber-rate.h"
+#include "ber-wire.h"
+#include <stdint.h>
+
+#ifdef BER_NODE_CONF_TABLE_SIZE
+#define BER_NODE_TABLE_SIZE BER_NODE_CONF_TABLE_SIZE
+#elif defined(NETSTACK_MAX_ROUTE_ENTRIES) && NETSTACK_MAX_ROUTE_ENTRIES > 255
+#define BER_NODE_TABLE_SIZE 255
+#elif defined(NETSTACK_MAX_ROUTE_ENTRIES)
+#define BER_NODE_TABLE_SIZE NETSTACK_MAX_ROUTE_ENTRIES
+#else
+#define BER_NODE_TABLE_SIZE 16
+#endif
+
+/* Nodes are indexed with a uint8_t; larger networks evict the oldest entry */
+#if BER_NODE_TABLE_SIZE > 255
+#error "BER_NODE_TABLE_SIZE must not exceed 255"
+#endif
+
+/* A forward jump larger than this is taken as a node reboot, not as loss */
+#ifdef BER_NODE_CONF_RESYNC_GAP
+#define BER_NODE_RESYNC_GAP BER_NODE_CONF_RESYNC_GAP
+#else
+#define BER_NODE_RESYNC_GAP 1024
+#endif
+
+/* Keep the printed address in each entry, see ber_node_addr_str() */
+#ifdef BER_NODE_CONF_ADDR_CACHE
+#define BER_NODE_ADDR_CACHE BER_NODE_CONF_ADDR_CACHE
+#else
+#define BER_NODE_ADDR_CACHE 1
+#endif
+
+#define BER_NODE_IID_OFFSET 8
+#define BER_NODE_WINDOW_SIZE 32
+
+/* Longest RFC 5952 address text, including the NUL */
+#define BER_NODE_ADDR_STR_SIZE 40
+
+/* Short node ID: the last two address bytes, as Contiki's node_id */
+#define BER_NODE_ID(addr) ((uint16_t)(((addr)[14] << 8) | (addr)[15]))
+
+/* Word order of the energest report, 8 big-endian uint32 */
+#define BER_ENERGEST_CPU          0
+#define BER_ENERGEST_LPM          1
+#define BER_ENERGEST_DEEP_LPM     2
+#define BER_ENERGEST_RADIO_TX     3
+#define BER_ENERGEST_RADIO_RX     4
+#define BER_ENERGEST_TOTAL        5
+#define BER_ENERGEST_PERIOD_TIME  6 /* Seconds */
+#define BER_ENERGEST_PERIOD_COUNT 7
+#define BER_ENERGEST_WORDS        8
+
+/* Results of ber_node_seq_update() and ber_node_energy_update() */
+#define BER_SEQ_NEW        0
+#define BER_SEQ_DUPLICATE  1
+
+/** \brief Sequence counters, in the order of the NODE_STATS record */
+struct ber_node_seq_stats {
+  uint32_t received;
+  uint32_t duplicates;
+  uint32_t lost;       /* Gaps in package_number not filled later */
+  uint32_t reordered;  /* Arrived after a higher package_number */
+  uint32_t last_seq;
+  uint32_t rate_limited; /* Dropped by admission control, see ber-rate.h */
+};
+
+/** \brief Energest ticks accumulated over all reports of a node */
+struct ber_node_energy {
+  uint64_t cpu;
+  uint64_t lpm;
+  uint64_t deep_lpm;
+  uint64_t radio_tx;
+  uint64_t radio_rx;
+  uint64_t total;
+  uint32_t seconds;      /* Sum of the reported period lengths */
+  uint32_t periods;      /* Reports accounted */
+  uint32_t last_period;  /* Period number of the last report */
+};
+
+/** \brief One sensor node */
+struct ber_node {
+  uint8_t addr[16];
+#if BER_NODE_ADDR_CACHE
+  char addr_str[BER_NODE_ADDR_STR_SIZE];
+#endif
+  uint16_t id;
+  uint8_t in_use;
+  uint8_t has_seq;
+  uint8_t has_energy;
+  uint8_t ack_pending;  /* Records received since the last ACK, ber-ack.h */
+  uint8_t legacy_port;  /* Sends from BER_UDP_LEGACY_CLIENT_PORT, ber.h */
+  uint32_t last_heard;  /* For eviction, see ber_node_lookup() */
+  uint32_t window;      /* Bit i set: last_seq - i has been received */
+  struct ber_node_seq_stats seq;
+  struct ber_node_energy energy;
+#if BER_WIRE_DELTA
+  struct ber_wire_state wire;  /* Reference for delta datagrams */
+#endif
+#if BER_RATE
+  struct ber_rate rate;
+#endif
+};
+
+/**
+ * \brief Find the entry of a node, creating it if needed
+ * \param addr 16-byte IPv6 address of the node
+ * \return The entry; never NULL, the least recently heard node is evicted
+ *         to make room
+ */
+struct ber_node *ber_node_lookup(const uint8_t *addr);
+
+/**
+ * \brief Find the entry of a node, without creating one or refreshing its
+ *        last heard time; for the output path
+ * \param addr 16-byte IPv6 address of the node
+ * \return The entry, or NULL if the node is not in the table
+ */
+struct ber_node *ber_node_find(const uint8_t *addr);
+
+/**
+ * \brief Account for a received package_number
+ * \param node The node entry
+ * \param seq The package_number of the datagram
+ * \return BER_SEQ_NEW, or BER_SEQ_DUPLICATE if the record was seen before
+ */
+int ber_node_seq_update(struct ber_node *node, uint32_t seq);
+
+/**
+ * \brief Whether a package_number was seen before, without accounting for it
+ *
+ *        The BER checks first and calls ber_node_seq_update() once the
+ *        record is queued, so the ACK window never claims a record that
+ *        was dropped.
+ * \param node The node entry
+ * \param seq The package_number of the datagram
+ * \return BER_SEQ_NEW, or BER_SEQ_DUPLICATE if ber_node_seq_update() would
+ *         report a duplicate
+ */
+int ber_node_seq_check(const struct ber_node *node, uint32_t seq);
+
+/**
+ * \brief Take back a package_number accounted by ber_node_seq_update(), for
+ *        a record dropped after all; the node's retransmit is then taken
+ *        as a late record
+ * \param node The node entry
+ * \param seq The package_number of the dropped record
+ */
+void ber_node_seq_forget(struct ber_node *node, uint32_t seq);
+
+/**
+ * \brief Add an energest report to the totals of a node
+ * \param node The node entry
+ * \param values The BER_ENERGEST_WORDS words of the report, in host order
+ * \return BER_SEQ_NEW, or BER_SEQ_DUPLICATE if this period was already
+ *         accounted
+ */
+int ber_node_energy_update(struct ber_node *node, const uint32_t *values);
+
+/**
+ * \brief Write an address in RFC 5952 form ("fd00::212:4b00:0:1")
+ * \param addr 16-byte IPv6 address
+ * \param buf Output, at least BER_NODE_ADDR_STR_SIZE bytes
+ */
+void ber_node_addr_to_str(const uint8_t *addr, char *buf);
+
+/**
+ * \brief The address of a node as text
+ * \param node The node entry
+ * \return The text; without BER_NODE_ADDR_CACHE it is only valid until the
+ *         next call
+ */
+const char *ber_node_addr_str(const struct ber_node *node);
+
+/**
+ * \brief Get a table entry by index, for iteration
+ * \param index 0 to BER_NODE_TABLE_SIZE - 1
+ * \return The entry, or NULL if the slot is unused
+ */
+struct ber_node *ber_node_get(uint8_t index);
+
+/**
+ * \brief Number of nodes in the table
+ */
+uint8_t ber_node_count(void);
+
+#endif /* BER_NODE_H_ */
+
+/** @} */
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Load-adaptive Orchestra rule for uplink traffic to the BER.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "contiki.h"
+
+#if BUILD_WITH_ORCHESTRA
+
+#include "ber-orchestra.h"
+#include "net/packetbuf.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/mac/tsch/tsch.h"
+
+#include "sys/log.h"
+#define LOG_MODULE "F4D"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+static uint16_t slotframe_handle;
+static struct tsch_slotframe *sf;
+static uint8_t cells = BER_ORCHESTRA_MIN_CELLS; /* Advertised or learned */
+
+/* Root */
+static uint8_t rx_cells;        /* Cells with an Rx link, >= cells */
+static uint32_t last_received;
+static struct tsch_asn_t last_asn;
+
+/* Node */
+static linkaddr_t root_lladdr;
+static uint8_t has_root;
+
+/*---------------------------------------------------------------------------*/
+static uint16_t
+cell_timeslot(uint8_t cell)
+{
+  return (uint16_t)cell * BER_ORCHESTRA_PERIOD / BER_ORCHESTRA_MAX_CELLS;
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_tx_links(const linkaddr_t *root)
+{
+  for(uint8_t i = 0; i < BER_ORCHESTRA_MAX_CELLS; i++) {
+    if(root != NULL) {
+      tsch_schedule_add_link(sf, LINK_OPTION_TX | LINK_OPTION_SHARED,
+                             LINK_TYPE_NORMAL, root, cell_timeslot(i),
+                             BER_ORCHESTRA_CHANNEL_OFFSET, 1);
+    } else {
+      tsch_schedule_remove_link_by_offsets(sf, cell_timeslot(i),
+                                           BER_ORCHESTRA_CHANNEL_OFFSET);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+update_root(void)
+{
+  uip_ipaddr_t root_ipaddr;
+  linkaddr_t lladdr;
+
+  if(!NETSTACK_ROUTING.get_root_ipaddr(&root_ipaddr)) {
+    if(has_root) {
+      set_tx_links(NULL);
+      has_root = 0;
+    }
+    return 0;
+  }
+
+  uip_ds6_set_lladdr_from_iid((uip_lladdr_t *)&lladdr, &root_ipaddr);
+  if(!has_root || !linkaddr_cmp(&lladdr, &root_lladdr)) {
+    /* Links to all cells up front; select_packet() picks among them */
+    linkaddr_copy(&root_lladdr, &lladdr);
+    set_tx_links(&root_lladdr);
+    has_root = 1;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+select_packet(uint16_t *slotframe, uint16_t *timeslot, uint16_t *channel_offset)
+{
+  const linkaddr_t *dest = packetbuf_addr(PACKETBUF_ADDR_RECEIVER);
+
+  if(sf == NULL || NETSTACK_ROUTING.node_is_root() ||
+     packetbuf_attr(PACKETBUF_ATTR_FRAME_TYPE) != FRAME802154_DATAFRAME ||
+     !update_root() || !linkaddr_cmp(dest, &root_lladdr)) {
+    return 0;
+  }
+
+  if(slotframe != NULL) {
+    *slotframe = slotframe_handle;
+  }
+  if(timeslot != NULL) {
+    *timeslot = cell_timeslot(ORCHESTRA_LINKADDR_HASH(&linkaddr_node_addr) %
+                              cells);
+  }
+  if(channel_offset != NULL) {
+    *channel_offset = BER_ORCHESTRA_CHANNEL_OFFSET;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(uint16_t handle)
+{
+  slotframe_handle = handle;
+  sf = tsch_schedule_add_slotframe(slotframe_handle, BER_ORCHESTRA_PERIOD);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_orchestra_root_start(void)
+{
+  if(sf == NULL) {
+    return;
+  }
+  cells = BER_ORCHESTRA_MIN_CELLS;
+  while(rx_cells < cells) {
+    tsch_schedule_add_link(sf, LINK_OPTION_RX, LINK_TYPE_NORMAL,
+                           &tsch_broadcast_address, cell_timeslot(rx_cells++),
+                           BER_ORCHESTRA_CHANNEL_OFFSET, 1);
+  }
+  last_asn = tsch_current_asn;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_orchestra_adapt(uint32_t received, int backlog)
+{
+  uint32_t slotframes;
+  uint32_t load;
+
+  if(sf == NULL || rx_cells == 0) {
+    return;
+  }
+
+  /* Nodes have had one round of ACKs to learn the last decrease */
+  while(rx_cells > cells) {
+    tsch_schedule_remove_link_by_offsets(sf, cell_timeslot(--rx_cells),
+                                         BER_ORCHESTRA_CHANNEL_OFFSET);
+  }
+
+  slotframes = TSCH_ASN_DIFF(tsch_current_asn, last_asn) / BER_ORCHESTRA_PERIOD;
+  last_asn = tsch_current_asn;
+  if(slotframes == 0) {
+    return;
+  }
+  load = (received - last_received) * 1000 / slotframes / cells;
+  last_received = received;
+
+  if(load > BER_ORCHESTRA_HIGH_PERMIL && cells < BER_ORCHESTRA_MAX_CELLS &&
+     !backlog) {
+    cells++;
+  } else if(load < BER_ORCHESTRA_LOW_PERMIL &&
+            cells > BER_ORCHESTRA_MIN_CELLS) {
+    cells--;
+  } else {
+    return;
+  }
+  LOG_INFO("Uplink load %lu permil per cell, now %u cells\n",
+           (unsigned long)load, cells);
+
+  while(rx_cells < cells) {
+    tsch_schedule_add_link(sf, LINK_OPTION_RX, LINK_TYPE_NORMAL,
+                           &tsch_broadcast_address, cell_timeslot(rx_cells++),
+                           BER_ORCHESTRA_CHANNEL_OFFSET, 1);
+  }
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_orchestra_get_cells(void)
+{
+  return cells;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_orchestra_set_cells(uint8_t count)
+{
+  if(count < BER_ORCHESTRA_MIN_CELLS) {
+    count = BER_ORCHESTRA_MIN_CELLS;
+  } else if(count > BER_ORCHESTRA_MAX_CELLS) {
+    count = BER_ORCHESTRA_MAX_CELLS;
+  }
+  cells = count;
+}
+/*---------------------------------------------------------------------------*/
+struct orchestra_rule ber_root_uplink = {
+  .init = init,
+  .select_packet = select_packet,
+  .name = "ber root uplink",
+};
+
+#endif /* BUILD_WITH_ORCHESTRA */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Load-adaptive Orchestra rule for uplink traffic to the BER.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         With the stock rules the root gets a single receiver-based cell per
+ *         unicast slotframe, like any other node, although every record in
+ *         the field ends up there. This rule adds a slotframe of
+ *         BER_ORCHESTRA_PERIOD slots with up to BER_ORCHESTRA_MAX_CELLS
+ *         shared cells, spread evenly, in which the root listens for its
+ *         children.
+ *
+ *         The root starts with BER_ORCHESTRA_MIN_CELLS and re-evaluates the
+ *         count periodically: when the records received per cell and
+ *         slotframe exceed BER_ORCHESTRA_HIGH_PERMIL it adds a cell, below
+ *         BER_ORCHESTRA_LOW_PERMIL it removes one. It does not add cells
+ *         while its output queue is dropping records, since the UART rather
+ *         than the schedule is the bottleneck then. A removed cell is still
+ *         listened on until the next evaluation, so nodes that have not yet
+ *         heard the new count do not lose packets.
+ *
+ *         Nodes running the same rule send frames for the root in cell
+ *         (hash of their address) % count. They learn the count from the
+ *         aggregated ACKs (ber-ack.h) and must pass it to
+ *         ber_orchestra_set_cells(); until then they use the minimum.
+ *         Nodes without the rule keep using the unicast rule's cells.
+ * @{
+ */
+#ifndef BER_ORCHESTRA_H_
+#define BER_ORCHESTRA_H_
+
+#include "contiki.h"
+#include "orchestra.h"
+
+#ifdef BER_ORCHESTRA_CONF_PERIOD
+#define BER_ORCHESTRA_PERIOD BER_ORCHESTRA_CONF_PERIOD
+#else
+#define BER_ORCHESTRA_PERIOD 11
+#endif
+
+#ifdef BER_ORCHESTRA_CONF_MIN_CELLS
+#define BER_ORCHESTRA_MIN_CELLS BER_ORCHESTRA_CONF_MIN_CELLS
+#else
+#define BER_ORCHESTRA_MIN_CELLS 1
+#endif
+
+#ifdef BER_ORCHESTRA_CONF_MAX_CELLS
+#define BER_ORCHESTRA_MAX_CELLS BER_ORCHESTRA_CONF_MAX_CELLS
+#else
+#define BER_ORCHESTRA_MAX_CELLS 4
+#endif
+
+#ifdef BER_ORCHESTRA_CONF_CHANNEL_OFFSET
+#define BER_ORCHESTRA_CHANNEL_OFFSET BER_ORCHESTRA_CONF_CHANNEL_OFFSET
+#else
+#define BER_ORCHESTRA_CHANNEL_OFFSET ORCHESTRA_UNICAST_MIN_CHANNEL_OFFSET
+#endif
+
+/* Records per cell and slotframe, in permil, that add or remove a cell */
+#ifdef BER_ORCHESTRA_CONF_HIGH_PERMIL
+#define BER_ORCHESTRA_HIGH_PERMIL BER_ORCHESTRA_CONF_HIGH_PERMIL
+#else
+#define BER_ORCHESTRA_HIGH_PERMIL 500
+#endif
+
+#ifdef BER_ORCHESTRA_CONF_LOW_PERMIL
+#define BER_ORCHESTRA_LOW_PERMIL BER_ORCHESTRA_CONF_LOW_PERMIL
+#else
+#define BER_ORCHESTRA_LOW_PERMIL 150
+#endif
+
+#if BER_ORCHESTRA_MIN_CELLS < 1 || \
+  BER_ORCHESTRA_MAX_CELLS < BER_ORCHESTRA_MIN_CELLS || \
+  BER_ORCHESTRA_MAX_CELLS > BER_ORCHESTRA_PERIOD
+#error "Need 1 <= BER_ORCHESTRA_MIN_CELLS <= MAX_CELLS <= PERIOD"
+#endif
+
+extern struct orchestra_rule ber_root_uplink;
+
+/**
+ * \brief Start listening on the minimum number of cells; call on the root
+ *        once it is the TSCH coordinator
+ */
+void ber_orchestra_root_start(void);
+
+/**
+ * \brief Re-evaluate the number of cells the root listens on
+ * \param received Records received so far, a running total
+ * \param backlog Non-zero if the output queue dropped records since the
+ *        last call
+ */
+void ber_orchestra_adapt(uint32_t received, int backlog);
+
+/**
+ * \brief Number of cells in use: advertised by the root, or learned by a node
+ */
+uint8_t ber_orchestra_get_cells(void);
+
+/**
+ * \brief Set the number of cells announced by the root, on a node
+ * \param cells Count from the ACK header, 0 if the root did not send one
+ */
+void ber_orchestra_set_cells(uint8_t cells);
+
+#endif /* BER_ORCHESTRA_H_ */
+
+/** @} */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Hot-path profiling of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-prof.h"
+#include <stddef.h>
+#include <string.h>
+#ifndef CONTIKI
+#include <time.h>
+#endif
+
+static const char *const stage_names[BER_PROF_STAGES] = {
+  "rx", "decode", "lookup", "format", "write"
+};
+
+#if BER_PROF
+static struct ber_prof_hist hist[BER_PROF_STAGES];
+#endif
+
+/*---------------------------------------------------------------------------*/
+void
+ber_prof_add(uint8_t stage, uint32_t ticks)
+{
+#if BER_PROF
+  struct ber_prof_hist *h = &hist[stage];
+  uint8_t b = 0;
+
+  while(b < BER_PROF_BUCKETS - 1 && (ticks >> b) != 0) {
+    b++;
+  }
+  h->buckets[b]++;
+  h->count++;
+  h->total += ticks;
+  if(ticks > h->max) {
+    h->max = ticks;
+  }
+#endif
+}
+/*---------------------------------------------------------------------------*/
+const struct ber_prof_hist *
+ber_prof_get(uint8_t stage)
+{
+#if BER_PROF
+  return stage < BER_PROF_STAGES ? &hist[stage] : NULL;
+#else
+  return NULL;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_prof_reset(void)
+{
+#if BER_PROF
+  memset(hist, 0, sizeof(hist));
+#endif
+}
+/*---------------------------------------------------------------------------*/
+const char *
+ber_prof_stage_name(uint8_t stage)
+{
+  return stage < BER_PROF_STAGES ? stage_names[stage] : "unknown";
+}
+/*---------------------------------------------------------------------------*/
+#ifndef CONTIKI
+uint32_t
+ber_prof_host_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000UL + ts.tv_nsec / 1000);
+}
+#endif /* CONTIKI */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Hot-path profiling of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Per-stage histograms of how long the record pipeline takes, in
+ *         rtimer ticks (microseconds on the host). Bucket i counts
+ *         durations below 2^i ticks that did not fit bucket i - 1; the
+ *         last bucket takes everything longer.
+ *
+ *         Enable with BER_CONF_PROF. When it is 0 the BER_PROF_START and
+ *         BER_PROF_STOP macros expand to nothing and no histogram memory
+ *         is allocated.
+ * @{
+ */
+#ifndef BER_PROF_H_
+#define BER_PROF_H_
+
+#include "ber-conf.h"
+#include <stdint.h>
+
+#ifdef BER_CONF_PROF
+#define BER_PROF BER_CONF_PROF
+#else
+#define BER_PROF 0
+#endif
+
+/* Stages */
+#define BER_PROF_RX      0 /* ber_record_input(), whole */
+#define BER_PROF_DECODE  1 /* Format lookup and package_number read */
+#define BER_PROF_LOOKUP  2 /* Node table lookup and sequence update */
+#define BER_PROF_FORMAT  3 /* ber_record_output(), whole */
+#define BER_PROF_WRITE   4 /* UART writes */
+#define BER_PROF_STAGES  5
+
+#define BER_PROF_BUCKETS 12
+
+/** \brief Histogram of one stage */
+struct ber_prof_hist {
+  uint32_t count;
+  uint32_t total;  /* Sum of all durations, in ticks */
+  uint32_t max;
+  uint32_t buckets[BER_PROF_BUCKETS];
+};
+
+#ifdef CONTIKI
+#include "sys/rtimer.h"
+typedef rtimer_clock_t ber_prof_time_t;
+#define BER_PROF_NOW() RTIMER_NOW()
+#define BER_PROF_DIFF(a, b) ((uint32_t)RTIMER_CLOCK_DIFF(a, b))
+#define BER_PROF_SECOND RTIMER_SECOND
+#else /* CONTIKI */
+typedef uint32_t ber_prof_time_t;
+uint32_t ber_prof_host_now(void);
+#define BER_PROF_NOW() ber_prof_host_now()
+#define BER_PROF_DIFF(a, b) ((uint32_t)((a) - (b)))
+#define BER_PROF_SECOND 1000000UL
+#endif /* CONTIKI */
+
+#if BER_PROF
+#define BER_PROF_START(t) ber_prof_time_t t = BER_PROF_NOW()
+#define BER_PROF_STOP(stage, t) \
+  ber_prof_add((stage), BER_PROF_DIFF(BER_PROF_NOW(), (t)))
+#else
+#define BER_PROF_START(t)
+#define BER_PROF_STOP(stage, t)
+#endif
+
+/**
+ * \brief Account one duration
+ * \param stage One of BER_PROF_*
+ * \param ticks Duration in BER_PROF_SECOND units
+ */
+void ber_prof_add(uint8_t stage, uint32_t ticks);
+
+/**
+ * \brief Get the histogram of a stage
+ * \param stage One of BER_PROF_*
+ * \return The histogram, or NULL if profiling is compiled out
+ */
+const struct ber_prof_hist *ber_prof_get(uint8_t stage);
+
+/**
+ * \brief Clear all histograms
+ */
+void ber_prof_reset(void);
+
+/**
+ * \brief Name of a stage, as printed in PROF records
+ */
+const char *ber_prof_stage_name(uint8_t stage);
+
+#endif /* BER_PROF_H_ */
+
+/** @} */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Received-record queue of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-queue.h"
+#include <string.h>
+
+static struct ber_record records[BER_QUEUE_SIZE];
+static uint8_t head;   /* Next slot to write */
+static uint8_t tail;   /* Oldest record */
+static uint8_t count;
+static struct ber_queue_stats stats;
+
+/*---------------------------------------------------------------------------*/
+int
+ber_queue_put(const uint8_t *addr, uint8_t type, uint32_t present,
+              const uint8_t *data, uint16_t len)
+{
+  struct ber_record *r;
+
+  if(len > BER_QUEUE_RECORD_SIZE) {
+    stats.oversize++;
+    return 0;
+  }
+
+  if(count == BER_QUEUE_SIZE) {
+    stats.dropped++;
+#if BER_QUEUE_DROP_OLDEST
+    ber_queue_pop();
+#else
+    return 0;
+#endif
+  }
+
+  r = &records[head];
+  memcpy(r->addr, addr, sizeof(r->addr));
+  r->type = type;
+  r->present = present;
+  memcpy(r->data, data, len);
+  r->len = (uint8_t)len;
+#if BER_TIME
+  r->asn = ber_time_now();
+#endif
+
+  head = (head + 1) % BER_QUEUE_SIZE;
+  count++;
+  stats.enqueued++;
+  if(count > stats.high_water) {
+    stats.high_water = count;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+struct ber_record *
+ber_queue_peek(void)
+{
+  return count > 0 ? &records[tail] : NULL;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_queue_pop(void)
+{
+  if(count > 0) {
+    tail = (tail + 1) % BER_QUEUE_SIZE;
+    count--;
+  }
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_queue_count(void)
+{
+  return count;
+}
+/*---------------------------------------------------------------------------*/
+const struct ber_queue_stats *
+ber_queue_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
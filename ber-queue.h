@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Received-record queue of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         A fixed-size ring of raw datagrams. The UDP callback only copies
+ *         the datagram and sender address in here; formatting and UART
+ *         output happen later in the BER output process, so the network
+ *         stack is never held up by a slow serial link. With BER_CONF_TIME
+ *         each record is also stamped with the network time it was queued
+ *         at.
+ *
+ *         When the ring is full the newest record is dropped, or the oldest
+ *         one is overwritten if BER_QUEUE_CONF_DROP_OLDEST is set. Both
+ *         cases are counted.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_QUEUE_H_
+#define BER_QUEUE_H_
+
+#include "ber-conf.h"
+#include "ber-time.h"
+#include <stdint.h>
+
+#ifdef BER_QUEUE_CONF_SIZE
+#define BER_QUEUE_SIZE BER_QUEUE_CONF_SIZE
+#else
+#define BER_QUEUE_SIZE 8
+#endif
+
+#ifdef BER_QUEUE_CONF_RECORD_SIZE
+#define BER_QUEUE_RECORD_SIZE BER_QUEUE_CONF_RECORD_SIZE
+#else
+#define BER_QUEUE_RECORD_SIZE 80
+#endif
+
+#ifdef BER_QUEUE_CONF_DROP_OLDEST
+#define BER_QUEUE_DROP_OLDEST BER_QUEUE_CONF_DROP_OLDEST
+#else
+#define BER_QUEUE_DROP_OLDEST 0
+#endif
+
+/** \brief One received datagram, in the fixed layout of its format */
+struct ber_record {
+  uint8_t addr[16];
+  uint8_t type;       /* BER_FRAME_TYPE_* */
+  uint8_t len;
+  uint32_t present;   /* Fields sent by the node, bit i for field i */
+#if BER_TIME
+  uint64_t asn;       /* When it was queued, see ber-time.h */
+#endif
+  uint8_t data[BER_QUEUE_RECORD_SIZE];
+};
+
+/** \brief Queue counters */
+struct ber_queue_stats {
+  uint32_t enqueued;
+  uint32_t dropped;    /* Lost because the queue was full */
+  uint32_t oversize;   /* Datagrams longer than BER_QUEUE_RECORD_SIZE */
+  uint8_t high_water;  /* Highest number of records queued at once */
+};
+
+/**
+ * \brief Copy a datagram into the queue
+ * \param addr 16-byte sender address
+ * \param type Record type, one of BER_FRAME_TYPE_*
+ * \param present Fields sent by the node, bit i for field i
+ * \param data Datagram bytes, in the fixed layout of \p type
+ * \param len Datagram length
+ * \return 1 if queued, 0 if dropped
+ */
+int ber_queue_put(const uint8_t *addr, uint8_t type, uint32_t present,
+                  const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Get the oldest queued record without removing it
+ * \return The record, or NULL if the queue is empty
+ */
+struct ber_record *ber_queue_peek(void);
+
+/**
+ * \brief Remove the oldest queued record
+ */
+void ber_queue_pop(void);
+
+/**
+ * \brief Number of records waiting in the queue
+ */
+uint8_t ber_queue_count(void);
+
+/**
+ * \brief Get the queue counters
+ */
+const struct ber_queue_stats *ber_queue_get_stats(void);
+
+#endif /* BER_QUEUE_H_ */
+
+/** @} */
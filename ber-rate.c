@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Per-node admission control of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-rate.h"
+#include "ber-frame.h"
+#include "ber-node.h"
+#include "ber-wire.h"
+#include <stddef.h>
+#ifndef CONTIKI
+#include <time.h>
+#endif
+
+/* Time between two tokens, and how far ahead of now a full bucket lets the
+   next token time run */
+struct rate_class {
+  uint32_t interval;
+  uint32_t burst;
+};
+
+#define RATE_CLASS(per_minute, burst) \
+  { 60 * BER_RATE_SECOND / (per_minute), \
+    ((burst) - 1) * (60 * BER_RATE_SECOND / (per_minute)) }
+
+static const struct rate_class classes[BER_RATE_CLASSES] = {
+  RATE_CLASS(BER_RATE_PING_PER_MINUTE, BER_RATE_PING_BURST),
+  RATE_CLASS(BER_RATE_DATA_PER_MINUTE, BER_RATE_DATA_BURST),
+  RATE_CLASS(BER_RATE_ENERGEST_PER_MINUTE, BER_RATE_ENERGEST_BURST),
+};
+
+#ifndef CONTIKI
+static uint32_t (*host_clock)(void);
+#endif
+
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_rate_class(const uint8_t *data, uint16_t len)
+{
+  if(BER_WIRE_HAS_HEADER(data, len)) {
+    return (data[1] & 0x0f) == BER_FRAME_TYPE_PING ? BER_RATE_PING :
+      BER_RATE_DATA;
+  }
+  if(len == 2) {
+    return BER_RATE_PING;
+  }
+  if(len == BER_ENERGEST_WORDS * 4) {
+    return BER_RATE_ENERGEST;
+  }
+  return BER_RATE_DATA;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_rate_admit(struct ber_rate *r, uint8_t cls, uint32_t now)
+{
+  const struct rate_class *c = &classes[cls];
+  uint32_t next = r->next[cls];
+
+  /* A bucket that has been full for a while gives no extra credit */
+  if(next == 0 || (int32_t)(now - next) > 0) {
+    next = now;
+  }
+  if(next - now > c->burst) {
+    return 0;
+  }
+  /* 0 means full, so never store it */
+  next += c->interval;
+  r->next[cls] = next != 0 ? next : 1;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+#ifndef CONTIKI
+void
+ber_rate_set_clock(uint32_t (*now)(void))
+{
+  host_clock = now;
+}
+#endif
+/*---------------------------------------------------------------------------*/
+uint32_t
+ber_rate_now(void)
+{
+#ifdef CONTIKI
+  return (uint32_t)clock_time();
+#else
+  struct timespec ts;
+
+  if(host_clock != NULL) {
+    return host_clock();
+  }
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000UL + ts.tv_nsec / 1000000);
+#endif
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
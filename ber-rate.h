@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Per-node admission control of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Every node gets one token bucket per message class. A datagram
+ *         takes a token from the bucket of its class, and datagrams that
+ *         find the bucket empty are dropped before they are decoded, so a
+ *         node stuck in a send loop or a reboot storm of PINGs cannot crowd
+ *         out the others.
+ *
+ *         A bucket refills at BER_RATE_*_PER_MINUTE tokens per minute and
+ *         holds at most BER_RATE_*_BURST. It is kept as the time its next
+ *         token would arrive at the steady rate (the GCRA form of a token
+ *         bucket), which takes one word per class instead of a token count
+ *         and a refill time.
+ *
+ *         This file has no Contiki dependencies beyond the clock, so that
+ *         host tools can share it with the firmware.
+ * @{
+ */
+#ifndef BER_RATE_H_
+#define BER_RATE_H_
+
+#include "ber-conf.h"
+#include <stdint.h>
+
+#ifdef BER_CONF_RATE
+#define BER_RATE BER_CONF_RATE
+#else
+#define BER_RATE 0
+#endif
+
+/* Message classes */
+#define BER_RATE_PING     0 /* 2-byte PINGs */
+#define BER_RATE_DATA     1 /* Sensor records, and lengths we do not know */
+#define BER_RATE_ENERGEST 2 /* Energest reports */
+#define BER_RATE_CLASSES  3
+
+/* Nodes report once a minute; leave room for retransmissions */
+#ifdef BER_RATE_CONF_DATA_PER_MINUTE
+#define BER_RATE_DATA_PER_MINUTE BER_RATE_CONF_DATA_PER_MINUTE
+#else
+#define BER_RATE_DATA_PER_MINUTE 12
+#endif
+
+#ifdef BER_RATE_CONF_DATA_BURST
+#define BER_RATE_DATA_BURST BER_RATE_CONF_DATA_BURST
+#else
+#define BER_RATE_DATA_BURST 8
+#endif
+
+/* A node PINGs once per boot */
+#ifdef BER_RATE_CONF_PING_PER_MINUTE
+#define BER_RATE_PING_PER_MINUTE BER_RATE_CONF_PING_PER_MINUTE
+#else
+#define BER_RATE_PING_PER_MINUTE 2
+#endif
+
+#ifdef BER_RATE_CONF_PING_BURST
+#define BER_RATE_PING_BURST BER_RATE_CONF_PING_BURST
+#else
+#define BER_RATE_PING_BURST 2
+#endif
+
+#ifdef BER_RATE_CONF_ENERGEST_PER_MINUTE
+#define BER_RATE_ENERGEST_PER_MINUTE BER_RATE_CONF_ENERGEST_PER_MINUTE
+#else
+#define BER_RATE_ENERGEST_PER_MINUTE 2
+#endif
+
+#ifdef BER_RATE_CONF_ENERGEST_BURST
+#define BER_RATE_ENERGEST_BURST BER_RATE_CONF_ENERGEST_BURST
+#else
+#define BER_RATE_ENERGEST_BURST 2
+#endif
+
+#ifdef CONTIKI
+#include "sys/clock.h"
+#define BER_RATE_SECOND CLOCK_SECOND
+#else
+#define BER_RATE_SECOND 1000UL /* Milliseconds on the host */
+#endif
+
+/** \brief The buckets of one node */
+struct ber_rate {
+  uint32_t next[BER_RATE_CLASSES]; /* When the bucket is full again, 0 = is */
+};
+
+/**
+ * \brief Class of a datagram: from the record type of a headered datagram
+ *        (see ber-wire.h), from the length of any other
+ * \param data Datagram bytes
+ * \param len Datagram length
+ * \return One of BER_RATE_*
+ */
+uint8_t ber_rate_class(const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Take a token for a datagram
+ * \param r The buckets of the sending node
+ * \param cls The class of the datagram
+ * \param now Current time, see ber_rate_now()
+ * \return 1 if the datagram may go on, 0 if it must be dropped
+ */
+int ber_rate_admit(struct ber_rate *r, uint8_t cls, uint32_t now);
+
+/**
+ * \brief Current time in BER_RATE_SECOND units
+ */
+uint32_t ber_rate_now(void);
+
+#ifndef CONTIKI
+/**
+ * \brief Replace the host clock, e.g. with the simulated time of a benchmark
+ * \param now The clock, in milliseconds; NULL restores the monotonic clock
+ */
+void ber_rate_set_clock(uint32_t (*now)(void));
+#endif
+
+#endif /* BER_RATE_H_ */
+
+/** @} */
@@ -0,0 +1,949 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Record pipeline of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-record.h"
+#include "ber.h"
+#include "ber-frame.h"
+#include "ber-json.h"
+#include "ber-prof.h"
+#include "ber-schema.h"
+#include "ber-summary.h"
+#include "ber-time.h"
+#include "ber-wire.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef CONTIKI
+#include "sys/log.h"
+#if CONTIKI_TARGET_SIMPLELINK
+#include "lib/dbg-io/dbg.h"
+#endif
+#define LOG_MODULE "F4D"
+#define LOG_LEVEL LOG_LEVEL_INFO
+#else /* CONTIKI */
+/* Same prefix as Contiki's logger, so host builds emit the same bytes */
+#define LOG_MODULE "F4D"
+#define LOG_INFO(...) \
+  do { printf("[INFO: %-10s] ", LOG_MODULE); printf(__VA_ARGS__); } while(0)
+#endif /* CONTIKI */
+
+#ifdef BER_CONF_OUTPUT_MODE
+#define BER_OUTPUT_MODE BER_CONF_OUTPUT_MODE
+#else
+#define BER_OUTPUT_MODE BER_OUTPUT_JSON
+#endif
+
+/* Send the 2-byte node ID instead of the address in binary record frames.
+   NODE_STATS and NODE_ENERGY frames keep the address, so the host can map
+   IDs back to addresses. */
+#ifdef BER_CONF_FRAME_NODE_ID
+#define BER_FRAME_NODE_ID BER_CONF_FRAME_NODE_ID
+#else
+#define BER_FRAME_NODE_ID 0
+#endif
+
+/* Drop records whose package_number was already seen from the same node */
+#ifdef BER_CONF_DROP_DUPLICATES
+#define BER_DROP_DUPLICATES BER_CONF_DROP_DUPLICATES
+#else
+#define BER_DROP_DUPLICATES 1
+#endif
+
+/* Write a "Received N bytes" banner before each JSON record */
+#ifdef BER_CONF_VERBOSE
+#define BER_VERBOSE BER_CONF_VERBOSE
+#else
+#define BER_VERBOSE 1
+#endif
+
+/* Record text is formatted into a buffer this size and written in chunks */
+#ifdef BER_CONF_TEXT_CHUNK_SIZE
+#define BER_TEXT_CHUNK_SIZE BER_CONF_TEXT_CHUNK_SIZE
+#else
+#define BER_TEXT_CHUNK_SIZE 128
+#endif
+
+#define BYTES_PER_UINT32 4
+#define ENERGEST_PAYLOAD_SIZE (BER_ENERGEST_WORDS * BYTES_PER_UINT32)
+
+static uint8_t output_mode = BER_OUTPUT_MODE;
+static uint8_t verbose = BER_VERBOSE;
+static uint8_t batch_count;
+static uint8_t batch_records; /* As announced by ber_record_batch_begin() */
+static uint32_t csv_headers; /* Kinds whose header row went out, kind_bit() */
+static struct ber_record_stats stats;
+
+/*---------------------------------------------------------------------------*/
+static void
+default_writer(const uint8_t *buf, size_t len)
+{
+#if CONTIKI_TARGET_SIMPLELINK
+  dbg_send_bytes(buf, len);
+#else
+  while(len-- > 0) {
+    putchar(*buf++);
+  }
+#endif
+}
+
+static void (*writer)(const uint8_t *buf, size_t len) = default_writer;
+/*---------------------------------------------------------------------------*/
+static void
+write_out(const uint8_t *buf, size_t len)
+{
+  BER_PROF_START(t);
+  stats.bytes_out += len;
+  writer(buf, len);
+  BER_PROF_STOP(BER_PROF_WRITE, t);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_set_writer(void (*write)(const uint8_t *buf, size_t len))
+{
+  writer = write != NULL ? write : default_writer;
+}
+/*---------------------------------------------------------------------------*/
+/* Record text takes the same path as binary frames, without printf */
+static void
+write_text(const char *s)
+{
+  write_out((const uint8_t *)s, strlen(s));
+}
+/*---------------------------------------------------------------------------*/
+static void
+flush_text(const char *buf, size_t len)
+{
+  write_out((const uint8_t *)buf, len);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_set_output_mode(uint8_t mode)
+{
+  if(mode <= BER_OUTPUT_CSV) {
+    /* A host switching to CSV gets the header rows again */
+    csv_headers = 0;
+    output_mode = mode;
+  }
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_get_output_mode(void)
+{
+  return output_mode;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_set_verbose(uint8_t v)
+{
+  verbose = v;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_record_get_verbose(void)
+{
+  return verbose;
+}
+/*---------------------------------------------------------------------------*/
+const struct ber_record_stats *
+ber_record_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+static void
+count_length(uint16_t len)
+{
+  struct ber_record_length_count *c;
+
+  for(c = stats.by_length; c < &stats.by_length[BER_RECORD_LENGTH_SLOTS]; c++) {
+    if(c->count == 0) {
+      c->len = len;
+    }
+    if(c->len == len) {
+      c->count++;
+      return;
+    }
+  }
+  stats.other_lengths++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+bytes_to_uint32(const uint8_t *bytes, uint32_t *num)
+{
+  *num = ((uint32_t)bytes[0] << 24) |
+    ((uint32_t)bytes[1] << 16) |
+    ((uint32_t)bytes[2] << 8) |
+    (uint32_t)bytes[3];
+}
+/*---------------------------------------------------------------------------*/
+static void
+parse_energest_data(const uint8_t *data, uint32_t *uint32_array)
+{
+  for(int i = 0; i < BER_ENERGEST_WORDS; i++) {
+    bytes_to_uint32(data + i * BYTES_PER_UINT32, &uint32_array[i]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if BER_QUEUE_DROP_OLDEST
+/* The oldest queued record is about to be overwritten: take it out of the
+   ACK window of its node, so the node sends it again */
+static void
+forget_oldest(void)
+{
+  const struct ber_record *r = ber_queue_peek();
+  const struct ber_payload_type *type = ber_schema_get(r->type);
+  struct ber_node *node;
+  uint32_t seq;
+
+  if(type != NULL && ber_schema_seq(type, r->data, &seq) &&
+     (r->present & (1UL << type->seq_field)) &&
+     (node = ber_node_find(r->addr)) != NULL) {
+    ber_node_seq_forget(node, seq);
+  }
+}
+#endif
+/*---------------------------------------------------------------------------*/
+static int
+input(const uint8_t *addr, const uint8_t *data, uint16_t len)
+{
+  const struct ber_payload_type *type;
+  const struct ber_wire_state *ref;
+  struct ber_node *node;
+  uint32_t energest[BER_ENERGEST_WORDS];
+  uint8_t record[BER_QUEUE_RECORD_SIZE];
+  uint32_t present;
+  int versioned;
+  uint8_t has_seq;
+  uint8_t duplicate;
+  uint32_t seq;
+#if BER_RATE
+  uint8_t cls;
+#endif
+
+  stats.received++;
+  count_length(len);
+  node = NULL;
+  ref = NULL;
+
+#if BER_RATE
+  /* A node over its rate costs us a table lookup and nothing more */
+  node = ber_node_lookup(addr);
+  cls = ber_rate_class(data, len);
+  if(!ber_rate_admit(&node->rate, cls, ber_rate_now())) {
+    node->seq.rate_limited++;
+    stats.rate_limited[cls]++;
+    return 0;
+  }
+#endif
+
+  /* Energest reports only feed the totals written by ber_record_node_energy().
+     They have no header; a headered record may well be 32 bytes long. */
+  if(len == ENERGEST_PAYLOAD_SIZE && !BER_WIRE_HAS_HEADER(data, len)) {
+    stats.energest++;
+    parse_energest_data(data, energest);
+    ber_node_energy_update(node != NULL ? node : ber_node_lookup(addr),
+                           energest);
+    return 0;
+  }
+
+  /* Only deltas need the node entry before they can be decoded */
+#if BER_WIRE_DELTA
+  if(BER_WIRE_IS_DELTA(data, len)) {
+    BER_PROF_START(t_ref);
+    if(node == NULL) {
+      node = ber_node_lookup(addr);
+    }
+    ref = &node->wire;
+    BER_PROF_STOP(BER_PROF_LOOKUP, t_ref);
+  }
+#endif
+
+  BER_PROF_START(t_decode);
+  versioned = ber_wire_decode(data, len, ref, record, sizeof(record), &type,
+                              &present);
+  has_seq = versioned >= 0 && ber_schema_seq(type, record, &seq) &&
+    (present & (1UL << type->seq_field));
+  BER_PROF_STOP(BER_PROF_DECODE, t_decode);
+
+  if(versioned == BER_WIRE_NO_REFERENCE) {
+    stats.no_reference++;
+    return 0;
+  }
+  if(versioned < 0) {
+    stats.unknown++;
+    if(verbose) {
+      LOG_INFO("Unexpected data length %u received.\n", len);
+    }
+    return 0;
+  }
+  stats.versioned += versioned;
+  stats.by_type[type->type]++;
+
+  /* Duplicates are dropped before they cost any formatting */
+  duplicate = 0;
+  if(has_seq) {
+    BER_PROF_START(t_lookup);
+    if(node == NULL) {
+      node = ber_node_lookup(addr);
+    }
+    duplicate = ber_node_seq_check(node, seq) == BER_SEQ_DUPLICATE;
+    BER_PROF_STOP(BER_PROF_LOOKUP, t_lookup);
+    if(duplicate) {
+      /* Counted, and ACKed again: the node missed our last ACK */
+      ber_node_seq_update(node, seq);
+      if(BER_DROP_DUPLICATES) {
+        stats.duplicates++;
+        return 0;
+      }
+    }
+#if BER_WIRE_DELTA
+    /* An old copy must not replace the reference of later deltas */
+    if(!duplicate && versioned == BER_WIRE_HEADER) {
+      ber_wire_update(&node->wire, type, record, seq);
+    }
+#endif
+  }
+
+#if BER_SUMMARY
+  /* Kept for the window summary, unless a threshold wants it out now */
+  if(!ber_summary_add(addr, type, record, present)) {
+    if(has_seq && !duplicate) {
+      ber_node_seq_update(node, seq);
+    }
+    return 0;
+  }
+#endif
+
+#if BER_QUEUE_DROP_OLDEST
+  if(ber_queue_count() == BER_QUEUE_SIZE) {
+    forget_oldest();
+  }
+#endif
+  /* Only a queued record goes into the ACK window: the node sends a
+     dropped one again */
+  if(!ber_queue_put(addr, type->type, present, record, type->length)) {
+    return 0;
+  }
+  if(has_seq && !duplicate) {
+    ber_node_seq_update(node, seq);
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_record_input(const uint8_t *addr, const uint8_t *data, uint16_t len)
+{
+  int queued;
+
+  BER_PROF_START(t);
+  queued = input(addr, data, len);
+  BER_PROF_STOP(BER_PROF_RX, t);
+  return queued;
+}
+/*---------------------------------------------------------------------------*/
+static void
+output_binary_frame(const struct ber_record *r)
+{
+  uint8_t frame[BER_FRAME_MAX_ENCODED_SIZE];
+  uint8_t payload[BER_QUEUE_RECORD_SIZE + 4];
+  const struct ber_payload_type *type = ber_schema_get(r->type);
+  uint16_t datalen = r->len;
+  size_t len;
+
+  if(type == NULL) {
+    return;
+  }
+  /* PING carries no fields, only its presence matters */
+  if(type->field_count == 0) {
+    datalen = 0;
+  }
+  memcpy(payload, r->data, datalen);
+
+  /* A record with missing fields is followed by its presence bitmap */
+  if(datalen > 0 && r->present != BER_SCHEMA_ALL_FIELDS) {
+    for(uint8_t i = 0; i < BER_WIRE_MASK_SIZE(type); i++) {
+      payload[datalen++] = r->present >> (8 * i);
+    }
+  }
+#if BER_FRAME_NODE_ID && BER_TIME
+  len = ber_frame_encode_node_id_asn(frame, sizeof(frame), type->type,
+                                     BER_NODE_ID(r->addr), payload, datalen,
+                                     r->asn);
+#elif BER_FRAME_NODE_ID
+  len = ber_frame_encode_node_id(frame, sizeof(frame), type->type,
+                                 BER_NODE_ID(r->addr), payload, datalen);
+#elif BER_TIME
+  len = ber_frame_encode_asn(frame, sizeof(frame), type->type, r->addr,
+                             payload, datalen, r->asn);
+#else
+  len = ber_frame_encode(frame, sizeof(frame), type->type, r->addr,
+                         payload, datalen);
+#endif
+  if(len > 0) {
+    write_out(frame, len);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* One bit per record kind: formats, internal types, then summaries */
+static uint32_t
+kind_bit(uint8_t type, uint8_t format)
+{
+  if(type == BER_FRAME_TYPE_SUMMARY) {
+    return 1UL << (BER_FRAME_TYPE_SUMMARY - BER_FRAME_TYPE_INTERNAL + 4 +
+                   format);
+  }
+  if(type > BER_FRAME_TYPE_INTERNAL) {
+    return 1UL << (type - BER_FRAME_TYPE_INTERNAL + 4);
+  }
+  return 1UL << type;
+}
+/*---------------------------------------------------------------------------*/
+/* Objects per line: 2 while the CSV header row of the kind is due */
+static uint8_t
+line_passes(uint8_t type, uint8_t format)
+{
+  uint32_t bit = kind_bit(type, format);
+
+  if(output_mode == BER_OUTPUT_CSV && !(csv_headers & bit)) {
+    csv_headers |= bit;
+    return 2;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+line_style(void)
+{
+  return output_mode == BER_OUTPUT_CSV ? BER_JSON_CSV : BER_JSON_COMPACT;
+}
+/*---------------------------------------------------------------------------*/
+/* A record as one NDJSON or CSV line, without markers or banners */
+static void
+write_line(struct ber_json *w, const struct ber_payload_type *type,
+           const uint8_t *data, uint32_t present, const char *key,
+           const char *value, const uint64_t *asn)
+{
+  for(uint8_t pass = line_passes(type->type, 0); pass > 0; pass--) {
+    ber_json_set_style(w, line_style(), type->name, pass > 1);
+    if(asn != NULL) {
+      ber_schema_write_json_object_at(w, type, data, present, key, value,
+                                      *asn);
+    } else {
+      ber_schema_write_json_object(w, type, data, present, key, value);
+    }
+    ber_json_char(w, '\n');
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* The address text of a sender. Output never creates node entries: with a
+   full table that would evict a node still sending, and its seq window,
+   rate buckets and delta reference with it. */
+static const char *
+sender_addr_str(const uint8_t *addr)
+{
+  static char buf[BER_NODE_ADDR_STR_SIZE];
+  const struct ber_node *n = ber_node_find(addr);
+
+  if(n != NULL) {
+    return ber_node_addr_str(n);
+  }
+  ber_node_addr_to_str(addr, buf);
+  return buf;
+}
+/*---------------------------------------------------------------------------*/
+/* Opens the batch array ahead of its first element, or separates the next
+   one. The banner waits for the first element too, so a batch whose
+   records all went to the store leaves no trace. */
+static void
+batch_element(struct ber_json *w)
+{
+  if(batch_count++ > 0) {
+    ber_json_str(w, ",\n");
+    return;
+  }
+  if(verbose) {
+    ber_json_flush(w);
+    LOG_INFO("############################################\n");
+    LOG_INFO("Batch of %u records\n", batch_records);
+    LOG_INFO("############################################\n");
+  }
+  ber_json_str(w, "\nJSON_BATCH_START\n[\n");
+}
+/*---------------------------------------------------------------------------*/
+static void
+output_json_record(const struct ber_record *r, uint8_t batched)
+{
+  const struct ber_payload_type *type;
+  const char *addr;
+  char buff[BER_TEXT_CHUNK_SIZE];
+  struct ber_json w;
+
+  /* The node entry holds the address text, unless BER_NODE_ADDR_CACHE is 0 */
+  BER_PROF_START(t);
+  addr = sender_addr_str(r->addr);
+  BER_PROF_STOP(BER_PROF_LOOKUP, t);
+
+  if(!batched && verbose && output_mode == BER_OUTPUT_JSON) {
+    LOG_INFO("############################################\n");
+    LOG_INFO("Received %u bytes, From %s \n", r->len, addr);
+    LOG_INFO("############################################\n");
+  }
+
+  type = ber_schema_get(r->type);
+  if(type == NULL) {
+    /* Handle unexpected data lengths */
+    LOG_INFO("Unexpected data length received.\n");
+    return;
+  }
+
+  if(output_mode != BER_OUTPUT_JSON) {
+    ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+#if BER_TIME
+    write_line(&w, type, r->data, r->present, "ipv6", addr, &r->asn);
+#else
+    write_line(&w, type, r->data, r->present, "ipv6", addr, NULL);
+#endif
+    ber_json_flush(&w);
+    return;
+  }
+
+  if(type->field_count == 0 && batched) {
+    /* Inside a batch a PING is an array element like any record, marked
+       with "record":"ping" as it has no fields to tell it by */
+    ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+    batch_element(&w);
+    ber_json_set_style(&w, BER_JSON_PRETTY, type->name, 0);
+#if BER_TIME
+    ber_schema_write_json_object_at(&w, type, r->data, r->present, "ipv6",
+                                    addr, r->asn);
+#else
+    ber_schema_write_json_object(&w, type, r->data, r->present, "ipv6", addr);
+#endif
+    ber_json_flush(&w);
+    return;
+  }
+
+  if(type->field_count == 0) {
+    /* Handle PING case */
+    write_text("\n\rPING received from: ");
+    write_text(addr);
+    write_text(" \n\r\n");
+    return;
+  }
+
+  /* One generic loop serves every format, see ber-schema.c. The text is
+     streamed out in chunks, so no record is too long for the buffer. */
+  ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+#if BER_TIME
+  /* Stamped records carry an "asn" member after the address */
+  if(batched) {
+    batch_element(&w);
+  } else {
+    ber_json_str(&w, "\nJSON_START\n");
+  }
+  ber_schema_write_json_object_at(&w, type, r->data, r->present, "ipv6", addr,
+                                  r->asn);
+  if(!batched) {
+    ber_json_str(&w, "\nJSON_END\n");
+  }
+#else
+  if(batched) {
+    batch_element(&w);
+    ber_schema_write_json_object(&w, type, r->data, r->present, "ipv6", addr);
+  } else {
+    ber_schema_write_json(&w, type, r->data, r->present, addr);
+  }
+#endif
+  ber_json_flush(&w);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_output(const struct ber_record *r, uint8_t batched)
+{
+  BER_PROF_START(t);
+  if(output_mode == BER_OUTPUT_BINARY) {
+    /* Raw fields go out as-is, the host decoder does the formatting */
+    output_binary_frame(r);
+  } else {
+    output_json_record(r, batched);
+  }
+  BER_PROF_STOP(BER_PROF_FORMAT, t);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_batch_begin(uint8_t records)
+{
+  batch_records = records;
+  batch_count = 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_batch_end(void)
+{
+  if(batch_count > 0) {
+    write_text("\n]\nJSON_BATCH_END\n");
+  }
+  batch_count = 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_u32_le(uint8_t *buf, uint32_t v)
+{
+  buf[0] = v & 0xff;
+  buf[1] = (v >> 8) & 0xff;
+  buf[2] = (v >> 16) & 0xff;
+  buf[3] = (v >> 24) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_stored(const struct ber_record *r, uint32_t seq, uint32_t stored_at)
+{
+  const struct ber_payload_type *type = ber_schema_get(BER_FRAME_TYPE_STORED);
+  uint8_t payload[2 * BYTES_PER_UINT32];
+  uint8_t frame[BER_FRAME_MAX_ENCODED_SIZE];
+  char buff[BER_TEXT_CHUNK_SIZE];
+  struct ber_json w;
+  const char *addr;
+  size_t len;
+
+  put_u32_le(&payload[0], seq);
+  put_u32_le(&payload[4], stored_at);
+
+  if(output_mode == BER_OUTPUT_BINARY) {
+    /* Addressed like the record it announces */
+#if BER_FRAME_NODE_ID
+    len = ber_frame_encode_node_id(frame, sizeof(frame), type->type,
+                                   BER_NODE_ID(r->addr), payload,
+                                   sizeof(payload));
+#else
+    len = ber_frame_encode(frame, sizeof(frame), type->type, r->addr,
+                           payload, sizeof(payload));
+#endif
+    if(len > 0) {
+      write_out(frame, len);
+    }
+    return;
+  }
+
+  addr = sender_addr_str(r->addr);
+  ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+  if(output_mode != BER_OUTPUT_JSON) {
+    write_line(&w, type, payload, BER_SCHEMA_ALL_FIELDS, "ipv6", addr, NULL);
+  } else {
+    ber_json_str(&w, "\nSTORED_START\n");
+    ber_schema_write_json_object(&w, type, payload, BER_SCHEMA_ALL_FIELDS,
+                                 "ipv6", addr);
+    ber_json_str(&w, "\nSTORED_END\n");
+  }
+  ber_json_flush(&w);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_anchor(uint32_t uptime)
+{
+  const struct ber_payload_type *type = ber_schema_get(BER_FRAME_TYPE_ANCHOR);
+  uint8_t payload[2 * BYTES_PER_UINT32];
+  uint8_t frame[BER_FRAME_MAX_ENCODED_SIZE];
+  char buff[BER_TEXT_CHUNK_SIZE];
+  struct ber_json w;
+  uint64_t asn;
+  size_t len;
+
+  put_u32_le(&payload[0], ber_time_slot_us());
+  put_u32_le(&payload[4], uptime);
+
+  /* Taken last, so that it is as close as we get to the bytes leaving */
+  asn = ber_time_now();
+
+  if(output_mode == BER_OUTPUT_BINARY) {
+    /* The node ID slot carries the time source */
+    len = ber_frame_encode_node_id_asn(frame, sizeof(frame), type->type,
+                                       ber_time_source(), payload,
+                                       sizeof(payload), asn);
+    if(len > 0) {
+      write_out(frame, len);
+    }
+    return;
+  }
+
+  ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+  if(output_mode != BER_OUTPUT_JSON) {
+    write_line(&w, type, payload, BER_SCHEMA_ALL_FIELDS, "clock",
+               ber_time_source_name(ber_time_source()), &asn);
+  } else {
+    ber_json_str(&w, "\nANCHOR_START\n");
+    ber_schema_write_json_object_at(&w, type, payload, BER_SCHEMA_ALL_FIELDS,
+                                    "clock",
+                                    ber_time_source_name(ber_time_source()),
+                                    asn);
+    ber_json_str(&w, "\nANCHOR_END\n");
+  }
+  ber_json_flush(&w);
+}
+/*---------------------------------------------------------------------------*/
+/* Record kinds of NDJSON and CSV summaries, by summarized format */
+static const char *const summary_kinds[] = {
+  NULL, "ping_summary", "co2_summary", "legacy_summary", "imf4d_summary"
+};
+/*---------------------------------------------------------------------------*/
+void
+ber_record_summary(const struct ber_summary *s, uint8_t first)
+{
+  uint8_t payload[BER_SUMMARY_HEADER_SIZE + BER_QUEUE_RECORD_SIZE + 4];
+  uint8_t frame[BER_FRAME_MAX_ENCODED_SIZE];
+  char buff[BER_TEXT_CHUNK_SIZE];
+  struct ber_json w;
+  const char *addr;
+  uint8_t datalen;
+  uint8_t passes;
+  size_t len;
+
+  ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+  addr = output_mode == BER_OUTPUT_BINARY ? NULL :
+    sender_addr_str(s->addr);
+  for(uint8_t stat = 0; stat < BER_SUMMARY_STATS; stat++) {
+    datalen = ber_summary_payload(s, stat, payload);
+
+    if(output_mode == BER_OUTPUT_BINARY) {
+      /* Addressed like the records it stands for */
+#if BER_FRAME_NODE_ID && BER_TIME
+      len = ber_frame_encode_node_id_asn(frame, sizeof(frame),
+                                         BER_FRAME_TYPE_SUMMARY,
+                                         BER_NODE_ID(s->addr), payload,
+                                         datalen, s->asn);
+#elif BER_FRAME_NODE_ID
+      len = ber_frame_encode_node_id(frame, sizeof(frame),
+                                     BER_FRAME_TYPE_SUMMARY,
+                                     BER_NODE_ID(s->addr), payload, datalen);
+#elif BER_TIME
+      len = ber_frame_encode_asn(frame, sizeof(frame), BER_FRAME_TYPE_SUMMARY,
+                                 s->addr, payload, datalen, s->asn);
+#else
+      len = ber_frame_encode(frame, sizeof(frame), BER_FRAME_TYPE_SUMMARY,
+                             s->addr, payload, datalen);
+#endif
+      if(len > 0) {
+        write_out(frame, len);
+      }
+      continue;
+    }
+
+    if(output_mode == BER_OUTPUT_JSON) {
+      ber_json_str(&w, first && stat == 0 ? "\nSUMMARY_START\n[\n" : ",\n");
+      passes = 1;
+    } else {
+      passes = line_passes(BER_FRAME_TYPE_SUMMARY, s->type);
+    }
+    for(; passes > 0; passes--) {
+      if(output_mode != BER_OUTPUT_JSON) {
+        ber_json_set_style(&w, line_style(), summary_kinds[s->type],
+                           passes > 1);
+      }
+#if BER_TIME
+      ber_summary_write_json(&w, payload, datalen, "ipv6", addr, &s->asn);
+#else
+      ber_summary_write_json(&w, payload, datalen, "ipv6", addr, NULL);
+#endif
+      if(output_mode != BER_OUTPUT_JSON) {
+        ber_json_char(&w, '\n');
+      }
+    }
+  }
+  if(output_mode != BER_OUTPUT_BINARY) {
+    ber_json_flush(&w);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_summary_end(uint8_t count)
+{
+  if(output_mode == BER_OUTPUT_JSON && count > 0) {
+    write_text("\n]\nSUMMARY_END\n");
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_node_stats(const struct ber_node *n, uint8_t first)
+{
+  const struct ber_payload_type *type = ber_schema_get(BER_FRAME_TYPE_NODE_STATS);
+  uint8_t payload[sizeof(struct ber_node_seq_stats)];
+  uint8_t frame[BER_FRAME_MAX_ENCODED_SIZE];
+  char buff[BER_TEXT_CHUNK_SIZE];
+  struct ber_json w;
+  size_t len;
+
+  put_u32_le(&payload[0], n->seq.received);
+  put_u32_le(&payload[4], n->seq.duplicates);
+  put_u32_le(&payload[8], n->seq.lost);
+  put_u32_le(&payload[12], n->seq.reordered);
+  put_u32_le(&payload[16], n->seq.last_seq);
+  put_u32_le(&payload[20], n->seq.rate_limited);
+
+  if(output_mode == BER_OUTPUT_BINARY) {
+    len = ber_frame_encode(frame, sizeof(frame), type->type, n->addr,
+                           payload, sizeof(payload));
+    if(len > 0) {
+      write_out(frame, len);
+    }
+    return;
+  }
+
+  ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+  if(output_mode != BER_OUTPUT_JSON) {
+    write_line(&w, type, payload, BER_SCHEMA_ALL_FIELDS, "ipv6", ber_node_addr_str(n), NULL);
+  } else {
+    ber_json_str(&w, first ? "\nNODE_STATS_START\n[\n" : ",\n");
+    ber_schema_write_json_object(&w, type, payload, BER_SCHEMA_ALL_FIELDS,
+                                 "ipv6", ber_node_addr_str(n));
+  }
+  ber_json_flush(&w);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_node_stats_end(uint8_t count)
+{
+  if(output_mode == BER_OUTPUT_JSON && count > 0) {
+    write_text("\n]\nNODE_STATS_END\n");
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Share of the node's time, in hundredths of a permil */
+static uint32_t
+permil100(uint64_t ticks, uint64_t total)
+{
+  return total > 0 ? (uint32_t)(ticks * 100000 / total) : 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_node_energy(const struct ber_node *n, uint8_t first)
+{
+  const struct ber_payload_type *type = ber_schema_get(BER_FRAME_TYPE_NODE_ENERGY);
+  const struct ber_node_energy *e = &n->energy;
+  uint8_t payload[7 * BYTES_PER_UINT32];
+  uint8_t frame[BER_FRAME_MAX_ENCODED_SIZE];
+  char buff[BER_TEXT_CHUNK_SIZE];
+  struct ber_json w;
+  size_t len;
+
+  put_u32_le(&payload[0], e->periods);
+  put_u32_le(&payload[4], e->seconds);
+  put_u32_le(&payload[8], permil100(e->cpu, e->total));
+  put_u32_le(&payload[12], permil100(e->lpm, e->total));
+  put_u32_le(&payload[16], permil100(e->deep_lpm, e->total));
+  put_u32_le(&payload[20], permil100(e->radio_tx, e->total));
+  put_u32_le(&payload[24], permil100(e->radio_rx, e->total));
+
+  if(output_mode == BER_OUTPUT_BINARY) {
+    len = ber_frame_encode(frame, sizeof(frame), type->type, n->addr,
+                           payload, sizeof(payload));
+    if(len > 0) {
+      write_out(frame, len);
+    }
+    return;
+  }
+
+  ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+  if(output_mode != BER_OUTPUT_JSON) {
+    write_line(&w, type, payload, BER_SCHEMA_ALL_FIELDS, "ipv6", ber_node_addr_str(n), NULL);
+  } else {
+    ber_json_str(&w, first ? "\nENERGY_START\n[\n" : ",\n");
+    ber_schema_write_json_object(&w, type, payload, BER_SCHEMA_ALL_FIELDS,
+                                 "ipv6", ber_node_addr_str(n));
+  }
+  ber_json_flush(&w);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_node_energy_end(uint8_t count)
+{
+  if(output_mode == BER_OUTPUT_JSON && count > 0) {
+    write_text("\n]\nENERGY_END\n");
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_prof(uint8_t stage, uint8_t first)
+{
+  const struct ber_payload_type *type = ber_schema_get(BER_FRAME_TYPE_PROF);
+  const struct ber_prof_hist *h = ber_prof_get(stage);
+  uint8_t payload[(4 + BER_PROF_BUCKETS) * BYTES_PER_UINT32];
+  uint8_t frame[BER_FRAME_MAX_ENCODED_SIZE];
+  char buff[BER_TEXT_CHUNK_SIZE];
+  struct ber_json w;
+  size_t len;
+
+  if(h == NULL) {
+    return;
+  }
+  put_u32_le(&payload[0], BER_PROF_SECOND);
+  put_u32_le(&payload[4], h->count);
+  put_u32_le(&payload[8], h->total);
+  put_u32_le(&payload[12], h->max);
+  for(uint8_t i = 0; i < BER_PROF_BUCKETS; i++) {
+    put_u32_le(&payload[16 + i * BYTES_PER_UINT32], h->buckets[i]);
+  }
+
+  if(output_mode == BER_OUTPUT_BINARY) {
+    /* The node ID slot carries the stage */
+    len = ber_frame_encode_node_id(frame, sizeof(frame), type->type, stage,
+                                   payload, sizeof(payload));
+    if(len > 0) {
+      write_out(frame, len);
+    }
+    return;
+  }
+
+  ber_json_init_stream(&w, buff, sizeof(buff), flush_text);
+  if(output_mode != BER_OUTPUT_JSON) {
+    write_line(&w, type, payload, BER_SCHEMA_ALL_FIELDS, "stage", ber_prof_stage_name(stage), NULL);
+  } else {
+    ber_json_str(&w, first ? "\nPROF_START\n[\n" : ",\n");
+    ber_schema_write_json_object(&w, type, payload, BER_SCHEMA_ALL_FIELDS,
+                                 "stage", ber_prof_stage_name(stage));
+  }
+  ber_json_flush(&w);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_record_prof_end(uint8_t count)
+{
+  if(output_mode == BER_OUTPUT_JSON && count > 0) {
+    write_text("\n]\nPROF_END\n");
+  }
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
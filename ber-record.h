@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Record pipeline of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Everything that happens to a datagram between the UDP callback
+ *         and the UART: duplicate suppression and queueing on the way in,
+ *         decoding and formatting on the way out. Keeping this apart from
+ *         the Contiki processes in ber.c lets the same code run on the
+ *         native target and in the host benchmark (tools/ber-bench).
+ * @{
+ */
+#ifndef BER_RECORD_H_
+#define BER_RECORD_H_
+
+#include "ber-conf.h"
+#include "ber-frame.h"
+#include "ber-queue.h"
+#include "ber-node.h"
+#include "ber-summary.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Distinct datagram lengths counted in ber_record_stats.by_length */
+#define BER_RECORD_LENGTH_SLOTS 8
+
+/** \brief Datagrams seen for one length */
+struct ber_record_length_count {
+  uint16_t len;
+  uint32_t count;
+};
+
+/** \brief Counters of the record pipeline, see ber_record_get_stats() */
+struct ber_record_stats {
+  uint32_t received;      /* All datagrams passed to ber_record_input() */
+  uint32_t by_type[BER_FRAME_TYPE_IMF4D + 1]; /* By BER_FRAME_TYPE_* */
+  uint32_t energest;      /* Energest reports */
+  uint32_t versioned;     /* Datagrams with a header, see ber-wire.h */
+  uint32_t unknown;       /* Dropped for an unknown length */
+  uint32_t no_reference;  /* Deltas dropped, their reference was lost */
+  uint32_t duplicates;    /* Dropped as duplicates */
+  uint32_t rate_limited[BER_RATE_CLASSES]; /* Dropped by class, ber-rate.h */
+  uint32_t other_lengths; /* Lengths that found no free by_length slot */
+  uint32_t bytes_out;     /* Record bytes written, log lines excluded */
+  struct ber_record_length_count by_length[BER_RECORD_LENGTH_SLOTS];
+};
+
+/**
+ * \brief Take in a received datagram
+ * \param addr 16-byte sender address
+ * \param data Datagram bytes
+ * \param len Datagram length
+ * \return 1 if the datagram was queued for output, 0 if it was dropped
+ *         (unknown length, duplicate or full queue) or, for an energest
+ *         report, added to the totals of the node
+ */
+int ber_record_input(const uint8_t *addr, const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Format and write one queued record in the current output mode
+ * \param r The record
+ * \param batched Non-zero to write it as an element of the current batch
+ */
+void ber_record_output(const struct ber_record *r, uint8_t batched);
+
+/**
+ * \brief Start a batch of JSON records
+ *
+ *        Nothing is written until the first record of the batch: a batch
+ *        that ends up empty leaves neither a banner nor an empty array.
+ * \param records Number of records the batch will hold
+ */
+void ber_record_batch_begin(uint8_t records);
+
+/**
+ * \brief Close the current batch, if any record was written to it
+ */
+void ber_record_batch_end(void);
+
+/**
+ * \brief Announce a record replayed from flash, see ber-store.h
+ *
+ *        Written just before the record itself, in the current output mode.
+ * \param r The record about to be written
+ * \param seq Its store sequence number
+ * \param stored_at Uptime in seconds when it was stored
+ */
+void ber_record_stored(const struct ber_record *r, uint32_t seq,
+                       uint32_t stored_at);
+
+/**
+ * \brief Write a time anchor, the current network time in the current
+ *        output mode
+ *
+ *        The host notes when the anchor arrives, and from that and the
+ *        slot length it carries maps the "asn" of stamped records to its
+ *        own clock, see ber-time.h.
+ * \param uptime Current uptime in seconds
+ */
+void ber_record_anchor(uint32_t uptime);
+
+/**
+ * \brief Write the summary of one window, see ber-summary.h
+ *
+ *        A summary is one record per statistic, in the layout of the
+ *        summarized format.
+ * \param s The slot
+ * \param first Non-zero for the first summary of a SUMMARY block
+ */
+void ber_record_summary(const struct ber_summary *s, uint8_t first);
+
+/**
+ * \brief Close a SUMMARY block
+ * \param count Number of summaries written
+ */
+void ber_record_summary_end(uint8_t count);
+
+/**
+ * \brief Write the sequence counters of one node
+ * \param n The node
+ * \param first Non-zero for the first node of a NODE_STATS block
+ */
+void ber_record_node_stats(const struct ber_node *n, uint8_t first);
+
+/**
+ * \brief Close a NODE_STATS block
+ * \param count Number of nodes written
+ */
+void ber_record_node_stats_end(uint8_t count);
+
+/**
+ * \brief Write the energest duty cycles of one node
+ * \param n The node, which must have has_energy set
+ * \param first Non-zero for the first node of an ENERGY block
+ */
+void ber_record_node_energy(const struct ber_node *n, uint8_t first);
+
+/**
+ * \brief Close an ENERGY block
+ * \param count Number of nodes written
+ */
+void ber_record_node_energy_end(uint8_t count);
+
+/**
+ * \brief Write the histogram of one profiling stage, see ber-prof.h
+ * \param stage One of BER_PROF_*
+ * \param first Non-zero for the first stage of a PROF block
+ */
+void ber_record_prof(uint8_t stage, uint8_t first);
+
+/**
+ * \brief Close a PROF block
+ * \param count Number of stages written
+ */
+void ber_record_prof_end(uint8_t count);
+
+/**
+ * \brief Get the pipeline counters
+ */
+const struct ber_record_stats *ber_record_get_stats(void);
+
+/**
+ * \brief Turn the log banner written before each JSON record on or off
+ *
+ *        NDJSON and CSV records never have one.
+ * \param verbose Non-zero for banners
+ */
+void ber_record_set_verbose(uint8_t verbose);
+
+/**
+ * \brief Whether JSON records are preceded by a log banner
+ */
+uint8_t ber_record_get_verbose(void);
+
+/**
+ * \brief Replace the function binary frames are written with
+ * \param write The writer; NULL restores the default (the debug UART)
+ */
+void ber_record_set_writer(void (*write)(const uint8_t *buf, size_t len));
+
+#endif /* BER_RECORD_H_ */
+
+/** @} */
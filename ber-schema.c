@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Payload schema registry for the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-schema.h"
+#include "ber.h"
+#include "ber-json.h"
+
+#define BYTES_PER_INT 4
+
+#define POW10(p) \
+  ((p) == 0 ? 1 : (p) == 1 ? 10 : (p) == 2 ? 100 : (p) == 3 ? 1000 : \
+   (p) == 4 ? 10000 : 100000)
+
+#define FIELD_KIND(p) ((p) == 0 ? BER_FIELD_INT : BER_FIELD_FIXED)
+
+/*---------------------------------------------------------------------------*/
+/* IMF4D base board, 76 bytes */
+#define IMF4D_INDEX(key, raw_key, precision) IMF4D_FIELD_##key,
+enum { IMF4D_BASE_SENSORS(IMF4D_INDEX) };
+
+#define IMF4D_FIELD(key, raw_key, precision)                                \
+  { #key, IMF4D_FIELD_##key * BYTES_PER_INT, FIELD_KIND(precision),         \
+    precision, 1, POW10(precision) },
+
+static const struct ber_field imf4d_fields[] = {
+  IMF4D_BASE_SENSORS(IMF4D_FIELD)
+};
+/*---------------------------------------------------------------------------*/
+/* IMF4D advanced board, 12 bytes */
+#define ADVANCED_INDEX(key, raw_key, precision) ADVANCED_FIELD_##key,
+enum { IMF4D_ADVANCED_SENSORS(ADVANCED_INDEX) };
+
+#define ADVANCED_FIELD(key, raw_key, precision)                             \
+  { #key, ADVANCED_FIELD_##key * BYTES_PER_INT, FIELD_KIND(precision),      \
+    precision, 1, POW10(precision) },
+
+static const struct ber_field co2_fields[] = {
+  IMF4D_ADVANCED_SENSORS(ADVANCED_FIELD)
+  { "package_number", IMF4D_ADVANCED_SENSORS_COUNT * BYTES_PER_INT,
+    BER_FIELD_INT, 0, 1, 1 },
+};
+/*---------------------------------------------------------------------------*/
+/* Legacy SensorTag board, 68 bytes */
+#define LEGACY_INDEX(key, offset, precision) LEGACY_FIELD_##key,
+enum { LEGACY_SENSORS(LEGACY_INDEX) };
+
+#define LEGACY_FIELD(key, offset, precision)                                \
+  { #key, offset, (precision) == 0 ? BER_FIELD_INT : BER_FIELD_SPLIT,       \
+    precision, 1, POW10(precision) },
+
+static const struct ber_field legacy_fields[] = {
+  LEGACY_SENSORS(LEGACY_FIELD)
+};
+/*---------------------------------------------------------------------------*/
+/* Per-node sequence counters, see ber-node.h */
+static const struct ber_field node_stats_fields[] = {
+  { "received", 0, BER_FIELD_INT, 0, 0, 1 },
+  { "duplicates", 4, BER_FIELD_INT, 0, 0, 1 },
+  { "lost", 8, BER_FIELD_INT, 0, 0, 1 },
+  { "reordered", 12, BER_FIELD_INT, 0, 0, 1 },
+  { "last_package_number", 16, BER_FIELD_INT, 0, 0, 1 },
+  { "rate_limited", 20, BER_FIELD_INT, 0, 0, 1 },
+};
+/*---------------------------------------------------------------------------*/
+/* Per-node energest totals, duty cycles in hundredths of a permil */
+static const struct ber_field node_energy_fields[] = {
+  { "periods", 0, BER_FIELD_INT, 0, 0, 1 },
+  { "seconds", 4, BER_FIELD_INT, 0, 0, 1 },
+  { "cpu_permil", 8, BER_FIELD_FIXED, 2, 0, 100 },
+  { "lpm_permil", 12, BER_FIELD_FIXED, 2, 0, 100 },
+  { "deep_lpm_permil", 16, BER_FIELD_FIXED, 2, 0, 100 },
+  { "radio_tx_permil", 20, BER_FIELD_FIXED, 2, 0, 100 },
+  { "radio_rx_permil", 24, BER_FIELD_FIXED, 2, 0, 100 },
+};
+/*---------------------------------------------------------------------------*/
+/* Stage histogram, see ber-prof.h; bucket names are upper bounds in ticks */
+static const struct ber_field prof_fields[] = {
+  { "ticks_per_second", 0, BER_FIELD_INT, 0, 0, 1 },
+  { "count", 4, BER_FIELD_INT, 0, 0, 1 },
+  { "total", 8, BER_FIELD_INT, 0, 0, 1 },
+  { "max", 12, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_1", 16, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_2", 20, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_4", 24, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_8", 28, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_16", 32, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_32", 36, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_64", 40, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_128", 44, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_256", 48, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_512", 52, BER_FIELD_INT, 0, 0, 1 },
+  { "lt_1024", 56, BER_FIELD_INT, 0, 0, 1 },
+  { "ge_1024", 60, BER_FIELD_INT, 0, 0, 1 },
+};
+/*---------------------------------------------------------------------------*/
+/* Written before a record replayed from flash, see ber-store.h */
+static const struct ber_field stored_fields[] = {
+  { "store_seq", 0, BER_FIELD_INT, 0, 0, 1 },
+  { "stored_at", 4, BER_FIELD_INT, 0, 0, 1 },
+};
+/*---------------------------------------------------------------------------*/
+/* Network time for the host to map stamps to wall-clock time, ber-time.h */
+static const struct ber_field anchor_fields[] = {
+  { "slot_us", 0, BER_FIELD_INT, 0, 0, 1 },
+  { "uptime", 4, BER_FIELD_INT, 0, 0, 1 },
+};
+/*---------------------------------------------------------------------------*/
+#define FIELD_COUNT(fields) (sizeof(fields) / sizeof(fields[0]))
+
+static const struct ber_payload_type payload_types[] = {
+  { BER_FRAME_TYPE_PING, 2, 0, -1, NULL, "ping" },
+  { BER_FRAME_TYPE_CO2, (IMF4D_ADVANCED_SENSORS_COUNT + 1) * BYTES_PER_INT,
+    FIELD_COUNT(co2_fields), IMF4D_ADVANCED_SENSORS_COUNT, co2_fields, "co2" },
+  { BER_FRAME_TYPE_LEGACY, 68, FIELD_COUNT(legacy_fields),
+    LEGACY_FIELD_package_number, legacy_fields, "legacy" },
+  { BER_FRAME_TYPE_IMF4D, IMF4D_BASE_SENSORS_COUNT * BYTES_PER_INT,
+    FIELD_COUNT(imf4d_fields), IMF4D_FIELD_package_number, imf4d_fields, "imf4d" },
+  { BER_FRAME_TYPE_NODE_STATS, FIELD_COUNT(node_stats_fields) * BYTES_PER_INT,
+    FIELD_COUNT(node_stats_fields), -1, node_stats_fields, "node_stats" },
+  { BER_FRAME_TYPE_NODE_ENERGY, FIELD_COUNT(node_energy_fields) * BYTES_PER_INT,
+    FIELD_COUNT(node_energy_fields), -1, node_energy_fields, "energy" },
+  { BER_FRAME_TYPE_PROF, FIELD_COUNT(prof_fields) * BYTES_PER_INT,
+    FIELD_COUNT(prof_fields), -1, prof_fields, "prof" },
+  { BER_FRAME_TYPE_STORED, FIELD_COUNT(stored_fields) * BYTES_PER_INT,
+    FIELD_COUNT(stored_fields), -1, stored_fields, "stored" },
+  { BER_FRAME_TYPE_ANCHOR, FIELD_COUNT(anchor_fields) * BYTES_PER_INT,
+    FIELD_COUNT(anchor_fields), -1, anchor_fields, "anchor" },
+};
+
+#define PAYLOAD_TYPE_COUNT FIELD_COUNT(payload_types)
+/*---------------------------------------------------------------------------*/
+const struct ber_payload_type *
+ber_schema_lookup(uint16_t datalen)
+{
+  for(size_t i = 0; i < PAYLOAD_TYPE_COUNT; i++) {
+    if(payload_types[i].length == datalen &&
+       payload_types[i].type < BER_FRAME_TYPE_INTERNAL) {
+      return &payload_types[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+const struct ber_payload_type *
+ber_schema_get(uint8_t type)
+{
+  for(size_t i = 0; i < PAYLOAD_TYPE_COUNT; i++) {
+    if(payload_types[i].type == type) {
+      return &payload_types[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_schema_seq(const struct ber_payload_type *type, const uint8_t *data,
+               uint32_t *seq)
+{
+  if(type->seq_field < 0) {
+    return 0;
+  }
+  *seq = (uint32_t)ber_schema_field_value(&type->fields[type->seq_field], data);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int32_t
+ber_schema_field_value(const struct ber_field *field, const uint8_t *data)
+{
+  const uint8_t *b = &data[field->offset];
+  return (int32_t)((uint32_t)b[0] | ((uint32_t)b[1] << 8) |
+                   ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24));
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_schema_write_json_fields(struct ber_json *w,
+                             const struct ber_payload_type *type,
+                             const uint8_t *data, uint32_t present)
+{
+  int32_t v;
+
+  for(uint8_t i = 0; i < type->field_count; i++) {
+    const struct ber_field *f = &type->fields[i];
+    if(!(present & (1UL << i))) {
+      ber_json_member_absent(w, f->name);
+      continue;
+    }
+    v = ber_schema_field_value(f, data);
+    ber_json_member(w, f->name);
+    switch(f->kind) {
+    case BER_FIELD_FIXED:
+      ber_json_fixed(w, v, f->precision);
+      break;
+    case BER_FIELD_SPLIT:
+      ber_json_split(w, v, ber_schema_field_value(f, data + BYTES_PER_INT),
+                     f->precision);
+      break;
+    default:
+      if(f->is_signed) {
+        ber_json_int(w, v);
+      } else {
+        ber_json_uint(w, (uint32_t)v);
+      }
+      break;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+write_object(struct ber_json *w, const struct ber_payload_type *type,
+             const uint8_t *data, uint32_t present, const char *key,
+             const char *value, const uint64_t *asn)
+{
+  ber_json_object_begin(w);
+  ber_json_member_str(w, key, value);
+  if(asn != NULL) {
+    ber_json_member(w, "asn");
+    ber_json_uint64(w, *asn);
+  }
+  ber_schema_write_json_fields(w, type, data, present);
+  ber_json_object_end(w);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_schema_write_json_object(struct ber_json *w,
+                             const struct ber_payload_type *type,
+                             const uint8_t *data, uint32_t present,
+                             const char *key, const char *value)
+{
+  write_object(w, type, data, present, key, value, NULL);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_schema_write_json_object_at(struct ber_json *w,
+                                const struct ber_payload_type *type,
+                                const uint8_t *data, uint32_t present,
+                                const char *key, const char *value,
+                                uint64_t asn)
+{
+  write_object(w, type, data, present, key, value, &asn);
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_schema_write_json(struct ber_json *w, const struct ber_payload_type *type,
+                      const uint8_t *data, uint32_t present, const char *ipv6)
+{
+  ber_json_str(w, "\nJSON_START\n");
+  ber_schema_write_json_object(w, type, data, present, "ipv6", ipv6);
+  ber_json_str(w, "\nJSON_END\n");
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_schema_to_json_object(char *buf, size_t size,
+                          const struct ber_payload_type *type,
+                          const uint8_t *data, const char *ipv6)
+{
+  return ber_schema_to_json_object_as(buf, size, type, data,
+                                      BER_SCHEMA_ALL_FIELDS, "ipv6", ipv6);
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_schema_to_json_object_as(char *buf, size_t size,
+                             const struct ber_payload_type *type,
+                             const uint8_t *data, uint32_t present,
+                             const char *key, const char *value)
+{
+  struct ber_json w;
+
+  ber_json_init(&w, buf, size);
+  ber_schema_write_json_object(&w, type, data, present, key, value);
+  return ber_json_result(&w);
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_schema_to_json_object_at(char *buf, size_t size,
+                             const struct ber_payload_type *type,
+                             const uint8_t *data, uint32_t present,
+                             const char *key, const char *value,
+                             uint64_t asn)
+{
+  struct ber_json w;
+
+  ber_json_init(&w, buf, size);
+  write_object(&w, type, data, present, key, value, &asn);
+  return ber_json_result(&w);
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_schema_to_json(char *buf, size_t size, const struct ber_payload_type *type,
+                   const uint8_t *data, uint32_t present, const char *ipv6)
+{
+  struct ber_json w;
+
+  ber_json_init(&w, buf, size);
+  ber_schema_write_json(&w, type, data, present, ipv6);
+  return ber_json_result(&w);
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Payload schema registry for the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         One const descriptor per datagram format, listing where each
+ *         sensor field sits in the payload and how it is scaled. The
+ *         tables are generated from the sensor lists in ber.h, so a new
+ *         board only needs a list there and an entry in ber-schema.c.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_SCHEMA_H_
+#define BER_SCHEMA_H_
+
+#include "ber-frame.h"
+#include "ber-json.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* How a field is encoded */
+#define BER_FIELD_INT    0 /* Plain integer */
+#define BER_FIELD_FIXED  1 /* Integer scaled by 10^precision */
+#define BER_FIELD_SPLIT  2 /* Integer part, then fractional part in the next int32 */
+
+/* Presence bitmap of a complete record; formats have at most 32 fields */
+#define BER_SCHEMA_ALL_FIELDS 0xffffffffUL
+
+/** \brief One int32 field of a payload */
+struct ber_field {
+  const char *name;
+  uint8_t offset;     /* Byte offset in the datagram */
+  uint8_t kind;       /* BER_FIELD_* */
+  uint8_t precision;  /* Decimal digits after the point */
+  uint8_t is_signed;
+  int32_t scale;      /* 10^precision */
+};
+
+/** \brief A datagram format */
+struct ber_payload_type {
+  uint8_t type;       /* BER_FRAME_TYPE_* */
+  uint8_t length;     /* Datagram length in bytes */
+  uint8_t field_count;
+  int8_t seq_field;   /* Index of the package_number field, or -1 */
+  const struct ber_field *fields;
+  const char *name;   /* Record kind in NDJSON and CSV output */
+};
+
+/**
+ * \brief Find the format of a datagram from its length
+ * \param datalen Datagram length in bytes
+ * \return The payload type, or NULL if no format has this length
+ */
+const struct ber_payload_type *ber_schema_lookup(uint16_t datalen);
+
+/**
+ * \brief Find a format from its record type
+ * \param type One of BER_FRAME_TYPE_*
+ * \return The payload type, or NULL if unknown
+ */
+const struct ber_payload_type *ber_schema_get(uint8_t type);
+
+/**
+ * \brief Read the sequence number (package_number) of a datagram
+ * \param type The payload type of \p data
+ * \param data The datagram
+ * \param seq Set to the sequence number
+ * \return 1 if the format carries a sequence number, 0 otherwise
+ */
+int ber_schema_seq(const struct ber_payload_type *type, const uint8_t *data,
+                   uint32_t *seq);
+
+/**
+ * \brief Read the raw int32 value of a field
+ * \param field The field descriptor
+ * \param data The datagram
+ * \return The raw value
+ */
+int32_t ber_schema_field_value(const struct ber_field *field,
+                               const uint8_t *data);
+
+/**
+ * \brief Format a datagram as a bare JSON object, as used in batches
+ * \param buf Output buffer
+ * \param size Size of \p buf
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param ipv6 Sender address string
+ * \return Number of characters written, excluding the terminating NUL,
+ *         or -1 if the object did not fit and was truncated
+ */
+int ber_schema_to_json_object(char *buf, size_t size,
+                              const struct ber_payload_type *type,
+                              const uint8_t *data, const char *ipv6);
+
+/**
+ * \brief Like ber_schema_to_json_object(), with a different sender key
+ * \param buf Output buffer
+ * \param size Size of \p buf
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param present Fields to include, bit i for field i
+ * \param key Name of the first member, e.g. "node_id"
+ * \param value Its value, printed as a JSON string
+ * \return As ber_schema_to_json_object()
+ */
+int ber_schema_to_json_object_as(char *buf, size_t size,
+                                 const struct ber_payload_type *type,
+                                 const uint8_t *data, uint32_t present,
+                                 const char *key, const char *value);
+
+/**
+ * \brief Like ber_schema_to_json_object_as(), with the reception time
+ * \param buf Output buffer
+ * \param size Size of \p buf
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param present Fields to include, bit i for field i
+ * \param key Name of the first member, e.g. "node_id"
+ * \param value Its value, printed as a JSON string
+ * \param asn Reception time in slots, written as the "asn" member
+ * \return As ber_schema_to_json_object()
+ */
+int ber_schema_to_json_object_at(char *buf, size_t size,
+                                 const struct ber_payload_type *type,
+                                 const uint8_t *data, uint32_t present,
+                                 const char *key, const char *value,
+                                 uint64_t asn);
+
+/**
+ * \brief Format a datagram as a JSON record between JSON_START/JSON_END
+ * \param buf Output buffer
+ * \param size Size of \p buf
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param present Fields to include, bit i for field i
+ * \param ipv6 Sender address string
+ * \return Number of characters written, excluding the terminating NUL,
+ *         or -1 if the record did not fit and was truncated
+ */
+int ber_schema_to_json(char *buf, size_t size,
+                       const struct ber_payload_type *type,
+                       const uint8_t *data, uint32_t present,
+                       const char *ipv6);
+
+/**
+ * \brief Append the fields of a datagram to an open JSON object
+ *
+ *        Each field is written with ber_json_member(), in schema order,
+ *        or with ber_json_member_absent() if it is not present.
+ * \param w The writer
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param present Fields to include, bit i for field i
+ */
+void ber_schema_write_json_fields(struct ber_json *w,
+                                  const struct ber_payload_type *type,
+                                  const uint8_t *data, uint32_t present);
+
+/**
+ * \brief Append a datagram as a bare JSON object to a writer
+ * \param w The writer, typically a streaming one
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param present Fields to include, bit i for field i
+ * \param key Name of the first member, "ipv6" for records
+ * \param value Its value, printed as a JSON string
+ */
+void ber_schema_write_json_object(struct ber_json *w,
+                                  const struct ber_payload_type *type,
+                                  const uint8_t *data, uint32_t present,
+                                  const char *key, const char *value);
+
+/**
+ * \brief Like ber_schema_write_json_object(), with the reception time
+ * \param w The writer, typically a streaming one
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param present Fields to include, bit i for field i
+ * \param key Name of the first member, "ipv6" for records
+ * \param value Its value, printed as a JSON string
+ * \param asn Reception time in slots, written as the "asn" member
+ */
+void ber_schema_write_json_object_at(struct ber_json *w,
+                                     const struct ber_payload_type *type,
+                                     const uint8_t *data, uint32_t present,
+                                     const char *key, const char *value,
+                                     uint64_t asn);
+
+/**
+ * \brief Append a datagram as a JSON record between JSON_START/JSON_END
+ * \param w The writer, typically a streaming one
+ * \param type The payload type of \p data
+ * \param data The datagram, at least type->length bytes
+ * \param present Fields to include, bit i for field i
+ * \param ipv6 Sender address string
+ */
+void ber_schema_write_json(struct ber_json *w,
+                           const struct ber_payload_type *type,
+                           const uint8_t *data, uint32_t present,
+                           const char *ipv6);
+
+#endif /* BER_SCHEMA_H_ */
+
+/** @} */
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Shell commands of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "contiki.h"
+#include "shell.h"
+#include "shell-commands.h"
+#include "ber.h"
+#include "ber-shell.h"
+#include "ber-record.h"
+#include "ber-summary.h"
+#include "ber-queue.h"
+#include "ber-node.h"
+#include "ber-prof.h"
+#include "ber-store.h"
+#if BUILD_WITH_ORCHESTRA
+#include "ber-orchestra.h"
+#endif
+#include <string.h>
+
+/* Names of the datagram formats, by BER_FRAME_TYPE_* */
+static const char *const type_names[] = {
+  NULL, "ping", "co2", "legacy", "imf4d"
+};
+
+/*---------------------------------------------------------------------------*/
+/* By BER_OUTPUT_* */
+static const char *const mode_names[] = { "json", "binary", "ndjson", "csv" };
+/*---------------------------------------------------------------------------*/
+static void
+print_stats(shell_output_func output)
+{
+  const struct ber_record_stats *s = ber_record_get_stats();
+  const struct ber_queue_stats *q = ber_queue_get_stats();
+  const struct ber_store_stats *st;
+#if BER_SUMMARY
+  const struct ber_summary_stats *sm;
+#endif
+  uint8_t i;
+
+  SHELL_OUTPUT(output, "Uptime: %lu s\n", (unsigned long)clock_seconds());
+  SHELL_OUTPUT(output, "Output: %s, verbose %s, %lu bytes written\n",
+               mode_names[ber_get_output_mode()],
+               ber_record_get_verbose() ? "on" : "off",
+               (unsigned long)s->bytes_out);
+  SHELL_OUTPUT(output, "Datagrams: %lu received, %lu with header, "
+               "%lu unknown length, %lu duplicates, %lu deltas without "
+               "reference\n",
+               (unsigned long)s->received, (unsigned long)s->versioned,
+               (unsigned long)s->unknown, (unsigned long)s->duplicates,
+               (unsigned long)s->no_reference);
+  for(i = 1; i < sizeof(type_names) / sizeof(type_names[0]); i++) {
+    SHELL_OUTPUT(output, "  %-8s %lu\n", type_names[i],
+                 (unsigned long)s->by_type[i]);
+  }
+  SHELL_OUTPUT(output, "  %-8s %lu\n", "energest", (unsigned long)s->energest);
+  SHELL_OUTPUT(output, "By length:");
+  for(i = 0; i < BER_RECORD_LENGTH_SLOTS && s->by_length[i].count > 0; i++) {
+    SHELL_OUTPUT(output, " %u:%lu", s->by_length[i].len,
+                 (unsigned long)s->by_length[i].count);
+  }
+  if(s->other_lengths > 0) {
+    SHELL_OUTPUT(output, " other:%lu", (unsigned long)s->other_lengths);
+  }
+  SHELL_OUTPUT(output, "\n");
+  SHELL_OUTPUT(output, "Queue: %u/%u, high water %u, %lu enqueued, "
+               "%lu dropped, %lu oversize\n", ber_queue_count(),
+               BER_QUEUE_SIZE, q->high_water, (unsigned long)q->enqueued,
+               (unsigned long)q->dropped, (unsigned long)q->oversize);
+  SHELL_OUTPUT(output, "Nodes: %u/%u\n", ber_node_count(), BER_NODE_TABLE_SIZE);
+  if(ber_store_ready()) {
+    st = ber_store_get_stats();
+    SHELL_OUTPUT(output, "Store: %lu pending, %lu stored, %lu replayed, "
+                 "%lu overwritten, %lu errors, host %s\n",
+                 (unsigned long)st->pending, (unsigned long)st->stored,
+                 (unsigned long)st->replayed, (unsigned long)st->overwritten,
+                 (unsigned long)st->errors, ber_host_up() ? "up" : "down");
+  }
+#if BER_SUMMARY
+  sm = ber_summary_get_stats();
+  SHELL_OUTPUT(output, "Summary: %s, %lu summarized, %lu over threshold, "
+               "%lu without slot, %lu windows written\n",
+               ber_summary_get_enabled() ? "on" : "off",
+               (unsigned long)sm->summarized, (unsigned long)sm->over_threshold,
+               (unsigned long)sm->no_slot, (unsigned long)sm->windows);
+#endif
+#if BER_RATE
+  SHELL_OUTPUT(output, "Rate limited: %lu ping, %lu data, %lu energest\n",
+               (unsigned long)s->rate_limited[BER_RATE_PING],
+               (unsigned long)s->rate_limited[BER_RATE_DATA],
+               (unsigned long)s->rate_limited[BER_RATE_ENERGEST]);
+#endif
+#if BUILD_WITH_ORCHESTRA
+  SHELL_OUTPUT(output, "Uplink cells: %u/%u\n", ber_orchestra_get_cells(),
+               BER_ORCHESTRA_MAX_CELLS);
+#endif
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_nodes(shell_output_func output)
+{
+  const struct ber_node *n;
+  uint8_t i;
+
+  SHELL_OUTPUT(output,
+               "id    received dup    lost   reord  limit  periods address\n");
+  for(i = 0; i < BER_NODE_TABLE_SIZE; i++) {
+    if((n = ber_node_get(i)) != NULL) {
+      SHELL_OUTPUT(output, "%-5u %-8lu %-6lu %-6lu %-6lu %-6lu %-7lu %s\n",
+                   n->id,
+                   (unsigned long)n->seq.received,
+                   (unsigned long)n->seq.duplicates,
+                   (unsigned long)n->seq.lost,
+                   (unsigned long)n->seq.reordered,
+                   (unsigned long)n->seq.rate_limited,
+                   (unsigned long)n->energy.periods,
+                   ber_node_addr_str(n));
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_prof(shell_output_func output)
+{
+  const struct ber_prof_hist *h;
+  uint8_t stage;
+  uint8_t i;
+
+  if(ber_prof_get(0) == NULL) {
+    SHELL_OUTPUT(output, "Profiling is disabled, build with BER_CONF_PROF\n");
+    return;
+  }
+  SHELL_OUTPUT(output, "Ticks per second: %lu; bucket i: < 2^i ticks\n",
+               (unsigned long)BER_PROF_SECOND);
+  for(stage = 0; stage < BER_PROF_STAGES; stage++) {
+    h = ber_prof_get(stage);
+    SHELL_OUTPUT(output, "%-6s n=%lu avg=%lu max=%lu |",
+                 ber_prof_stage_name(stage), (unsigned long)h->count,
+                 (unsigned long)(h->count > 0 ? h->total / h->count : 0),
+                 (unsigned long)h->max);
+    for(i = 0; i < BER_PROF_BUCKETS; i++) {
+      SHELL_OUTPUT(output, " %lu", (unsigned long)h->buckets[i]);
+    }
+    SHELL_OUTPUT(output, "\n");
+  }
+}
+/*---------------------------------------------------------------------------*/
+static
+PT_THREAD(cmd_ber(struct pt *pt, shell_output_func output, char *args))
+{
+  char *next_args;
+
+  PT_BEGIN(pt);
+
+  SHELL_ARGS_INIT(args, next_args);
+  SHELL_ARGS_NEXT(args, next_args);
+
+  if(args == NULL || !strcmp(args, "stats")) {
+    print_stats(output);
+  } else if(!strcmp(args, "alive")) {
+    ber_host_alive();
+  } else if(!strcmp(args, "anchor")) {
+    ber_anchor();
+  } else if(!strcmp(args, "nodes")) {
+    print_nodes(output);
+  } else if(!strcmp(args, "mode")) {
+    SHELL_ARGS_NEXT(args, next_args);
+    if(args != NULL && !strcmp(args, "json")) {
+      ber_set_output_mode(BER_OUTPUT_JSON);
+    } else if(args != NULL && !strcmp(args, "ndjson")) {
+      ber_set_output_mode(BER_OUTPUT_NDJSON);
+    } else if(args != NULL && !strcmp(args, "csv")) {
+      ber_set_output_mode(BER_OUTPUT_CSV);
+    } else if(args != NULL && !strcmp(args, "binary")) {
+      ber_set_output_mode(BER_OUTPUT_BINARY);
+    } else {
+      SHELL_OUTPUT(output, "Usage: ber mode json|ndjson|csv|binary\n");
+    }
+  } else if(!strcmp(args, "prof")) {
+    SHELL_ARGS_NEXT(args, next_args);
+    if(args != NULL && !strcmp(args, "reset")) {
+      ber_prof_reset();
+    } else {
+      print_prof(output);
+    }
+  } else if(!strcmp(args, "summary")) {
+    SHELL_ARGS_NEXT(args, next_args);
+    if(!BER_SUMMARY) {
+      SHELL_OUTPUT(output, "Summaries are disabled, build with "
+                   "BER_CONF_SUMMARY\n");
+    } else if(args != NULL && !strcmp(args, "on")) {
+      ber_summary_set_enabled(1);
+    } else if(args != NULL && !strcmp(args, "off")) {
+      /* Whatever the window holds still goes out when it closes */
+      ber_summary_set_enabled(0);
+    } else if(args != NULL && !strcmp(args, "close")) {
+      ber_summary_close();
+    } else {
+      SHELL_OUTPUT(output, "Usage: ber summary on|off|close\n");
+    }
+  } else if(!strcmp(args, "verbose")) {
+    SHELL_ARGS_NEXT(args, next_args);
+    if(args != NULL && !strcmp(args, "on")) {
+      ber_record_set_verbose(1);
+    } else if(args != NULL && !strcmp(args, "off")) {
+      ber_record_set_verbose(0);
+    } else {
+      SHELL_OUTPUT(output, "Usage: ber verbose on|off\n");
+    }
+  } else {
+    SHELL_OUTPUT(output, "Unknown subcommand: %s\n", args);
+  }
+
+  PT_END(pt);
+}
+/*---------------------------------------------------------------------------*/
+static const struct shell_command_t ber_commands[] = {
+  { "ber", cmd_ber, "'> ber [stats|nodes|mode json|ndjson|csv|binary|verbose on|off|"
+    "prof [reset]|summary on|off|close|alive|anchor]': BER counters and "
+    "output control" },
+  { NULL, NULL, NULL },
+};
+
+static struct shell_command_set_t ber_command_set = {
+  .next = NULL,
+  .commands = ber_commands,
+};
+/*---------------------------------------------------------------------------*/
+void
+ber_shell_init(void)
+{
+  shell_command_set_register(&ber_command_set);
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Shell commands of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Registers the "ber" command with the Contiki-NG shell:
+ *
+ *         - ber [stats]            Datagram, output and queue counters
+ *         - ber nodes              Per-node sequence and energest counts
+ *         - ber mode json|ndjson|csv|binary
+ *                                  Switch the output format
+ *         - ber verbose on|off     Log banners before JSON records
+ *         - ber prof [reset]       Stage timing histograms (BER_CONF_PROF)
+ *         - ber summary on|off|close
+ *                                  Windowed summaries (BER_CONF_SUMMARY);
+ *                                  close writes the open windows now
+ *         - ber alive              Host keepalive, see BER_CONF_STORE
+ *         - ber anchor             Write a time anchor now (BER_CONF_TIME)
+ * @{
+ */
+#ifndef BER_SHELL_H_
+#define BER_SHELL_H_
+
+/**
+ * \brief Register the BER shell commands
+ */
+void ber_shell_init(void);
+
+#endif /* BER_SHELL_H_ */
+
+/** @} */
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Flash regions for the BER record store, one per platform.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         The LaunchPad keeps the store in its external SPI flash. The
+ *         native and Cooja targets have no flash, so a file stands in for
+ *         it, with the same erase and program behavior as seen by
+ *         ber-store.c.
+ * @{
+ */
+#include "contiki.h"
+#include "ber-store.h"
+
+/* Region size; the LaunchPad's MX25R8035F holds 1 MB */
+#ifdef BER_STORE_CONF_SIZE
+#define BER_STORE_SIZE BER_STORE_CONF_SIZE
+#else
+#define BER_STORE_SIZE (512 * 1024UL)
+#endif
+
+#if CONTIKI_TARGET_SIMPLELINK
+/*---------------------------------------------------------------------------*/
+#include "ext-flash.h"
+
+/* Start of the region; the lower half is left to firmware images */
+#ifdef BER_STORE_CONF_OFFSET
+#define BER_STORE_OFFSET BER_STORE_CONF_OFFSET
+#else
+#define BER_STORE_OFFSET (512 * 1024UL)
+#endif
+
+/*---------------------------------------------------------------------------*/
+static int
+flash_read(uint32_t offset, uint8_t *buf, size_t len)
+{
+  bool ok;
+
+  if(!ext_flash_open(NULL)) {
+    return -1;
+  }
+  ok = ext_flash_read(NULL, BER_STORE_OFFSET + offset, len, buf);
+  ext_flash_close(NULL);
+  return ok ? 0 : -1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+flash_write(uint32_t offset, const uint8_t *buf, size_t len)
+{
+  bool ok;
+
+  if(!ext_flash_open(NULL)) {
+    return -1;
+  }
+  ok = ext_flash_write(NULL, BER_STORE_OFFSET + offset, len, buf);
+  ext_flash_close(NULL);
+  return ok ? 0 : -1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+flash_erase(uint32_t offset, size_t len)
+{
+  bool ok;
+
+  if(!ext_flash_open(NULL)) {
+    return -1;
+  }
+  ok = ext_flash_erase(NULL, BER_STORE_OFFSET + offset, len);
+  ext_flash_close(NULL);
+  return ok ? 0 : -1;
+}
+/*---------------------------------------------------------------------------*/
+#elif CONTIKI_TARGET_NATIVE || CONTIKI_TARGET_COOJA
+/*---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#ifdef BER_STORE_CONF_FILE
+#define BER_STORE_FILE BER_STORE_CONF_FILE
+#else
+#define BER_STORE_FILE "ber-store.bin"
+#endif
+
+static FILE *file;
+
+/*---------------------------------------------------------------------------*/
+static int
+fill_erased(size_t len)
+{
+  uint8_t erased[64];
+  size_t n;
+
+  memset(erased, 0xff, sizeof(erased));
+  while(len > 0) {
+    n = len < sizeof(erased) ? len : sizeof(erased);
+    if(fwrite(erased, 1, n, file) != n) {
+      return -1;
+    }
+    len -= n;
+  }
+  fflush(file);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Open the file, creating it erased if it is missing or too short */
+static int
+flash_open(void)
+{
+  long size;
+
+  if(file != NULL) {
+    return 0;
+  }
+  if((file = fopen(BER_STORE_FILE, "r+b")) == NULL &&
+     (file = fopen(BER_STORE_FILE, "w+b")) == NULL) {
+    return -1;
+  }
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  if(size >= 0 && size < (long)BER_STORE_SIZE) {
+    return fill_erased(BER_STORE_SIZE - size);
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+flash_read(uint32_t offset, uint8_t *buf, size_t len)
+{
+  if(flash_open() != 0 || fseek(file, offset, SEEK_SET) != 0 ||
+     fread(buf, 1, len, file) != len) {
+    return -1;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+flash_write(uint32_t offset, const uint8_t *buf, size_t len)
+{
+  if(flash_open() != 0 || fseek(file, offset, SEEK_SET) != 0 ||
+     fwrite(buf, 1, len, file) != len) {
+    return -1;
+  }
+  /* Flash keeps what was programmed across a crash, so should the file */
+  fflush(file);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+flash_erase(uint32_t offset, size_t len)
+{
+  if(flash_open() != 0 || fseek(file, offset, SEEK_SET) != 0) {
+    return -1;
+  }
+  return fill_erased(len);
+}
+/*---------------------------------------------------------------------------*/
+#endif /* CONTIKI_TARGET_NATIVE || CONTIKI_TARGET_COOJA */
+
+#if CONTIKI_TARGET_SIMPLELINK || CONTIKI_TARGET_NATIVE || CONTIKI_TARGET_COOJA
+static const struct ber_store_flash platform_flash = {
+  BER_STORE_SIZE, flash_read, flash_write, flash_erase
+};
+#endif
+/*---------------------------------------------------------------------------*/
+const struct ber_store_flash *
+ber_store_platform_flash(void)
+{
+#if CONTIKI_TARGET_SIMPLELINK || CONTIKI_TARGET_NATIVE || CONTIKI_TARGET_COOJA
+  return &platform_flash;
+#else
+  return NULL;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
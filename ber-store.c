@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Store-and-forward of BER records on flash.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-store.h"
+#include <string.h>
+
+#define NO_ENTRY 0xffffffffUL
+
+static const struct ber_store_flash *flash;
+static uint32_t sectors;
+static uint32_t head;      /* Where the next entry goes */
+static uint32_t head_sector; /* The sector erased for writing */
+static uint32_t tail;      /* No pending entry lies before this one */
+static uint32_t peeked = NO_ENTRY;
+static uint32_t next_seq;
+static struct ber_store_stats stats;
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+get_u32_le(const uint8_t *b)
+{
+  return (uint32_t)b[0] | ((uint32_t)b[1] << 8) |
+         ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_u32_le(uint8_t *b, uint32_t v)
+{
+  b[0] = v & 0xff;
+  b[1] = (v >> 8) & 0xff;
+  b[2] = (v >> 16) & 0xff;
+  b[3] = (v >> 24) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+sector_start(uint32_t offset)
+{
+  return offset - offset % BER_STORE_SECTOR_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+next_sector(uint32_t offset)
+{
+  offset = sector_start(offset) + BER_STORE_SECTOR_SIZE;
+  return offset < flash->size ? offset : 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Size of the entry at offset, or 0 if the rest of its sector is empty */
+static uint32_t
+read_header(uint32_t offset, uint8_t *hdr)
+{
+  uint32_t room = BER_STORE_SECTOR_SIZE - offset % BER_STORE_SECTOR_SIZE;
+  uint32_t size;
+
+  if(room < BER_STORE_HEADER_SIZE) {
+    return 0;
+  }
+  if(flash->read(offset, hdr, BER_STORE_HEADER_SIZE) != 0) {
+    stats.errors++;
+    return 0;
+  }
+  size = BER_STORE_HEADER_SIZE + hdr[2];
+  if(hdr[0] != BER_STORE_MAGIC || hdr[2] > BER_QUEUE_RECORD_SIZE ||
+     size > room) {
+    return 0;
+  }
+  return size;
+}
+/*---------------------------------------------------------------------------*/
+/* Offset of whatever follows an entry, moving on to the next sector if no
+   further entry fits in this one */
+static uint32_t
+skip(uint32_t offset, uint32_t size)
+{
+  offset += size;
+  if(BER_STORE_SECTOR_SIZE - offset % BER_STORE_SECTOR_SIZE <
+     BER_STORE_HEADER_SIZE || offset % BER_STORE_SECTOR_SIZE == 0) {
+    return next_sector(offset - 1);
+  }
+  return offset;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+count_pending(uint32_t start)
+{
+  uint8_t hdr[BER_STORE_HEADER_SIZE];
+  uint32_t offset = start;
+  uint32_t size;
+  uint32_t count = 0;
+
+  while(sector_start(offset) == start &&
+        (size = read_header(offset, hdr)) > 0) {
+    if(hdr[1] == BER_STORE_STATE_PENDING) {
+      count++;
+    }
+    offset += size;
+  }
+  return count;
+}
+/*---------------------------------------------------------------------------*/
+/* Erase a sector for writing, dropping the records still pending in it */
+static int
+open_sector(uint32_t start)
+{
+  uint32_t lost;
+
+  if(stats.pending > 0 && sector_start(tail) == start) {
+    lost = count_pending(start);
+    stats.pending -= lost;
+    stats.overwritten += lost;
+    tail = next_sector(start);
+  }
+  if(peeked != NO_ENTRY && sector_start(peeked) == start) {
+    peeked = NO_ENTRY;
+  }
+  head = head_sector = start;
+  if(stats.pending == 0) {
+    tail = head;
+  }
+  if(flash->erase(start, BER_STORE_SECTOR_SIZE) != 0) {
+    stats.errors++;
+    return -1;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_store_init(const struct ber_store_flash *f)
+{
+  uint8_t hdr[BER_STORE_HEADER_SIZE];
+  uint32_t newest = NO_ENTRY;
+  uint32_t newest_seq = 0;
+  uint32_t offset;
+  uint32_t size;
+  uint32_t s;
+
+  memset(&stats, 0, sizeof(stats));
+  peeked = NO_ENTRY;
+  flash = NULL;
+  if(f == NULL || f->size < 2 * BER_STORE_SECTOR_SIZE ||
+     f->size % BER_STORE_SECTOR_SIZE != 0) {
+    return -1;
+  }
+  flash = f;
+  sectors = f->size / BER_STORE_SECTOR_SIZE;
+
+  /* The sector whose first entry is the most recent one is written last */
+  for(s = 0; s < sectors; s++) {
+    offset = s * BER_STORE_SECTOR_SIZE;
+    hdr[0] = 0xff;
+    if(read_header(offset, hdr) > 0) {
+      if(newest == NO_ENTRY || get_u32_le(&hdr[4]) > newest_seq) {
+        newest = offset;
+        newest_seq = get_u32_le(&hdr[4]);
+      }
+    } else if(hdr[0] != 0xff && flash->erase(offset,
+                                               BER_STORE_SECTOR_SIZE) != 0) {
+      /* Neither a log sector nor erased: not ours, reclaim it */
+      stats.errors++;
+    }
+  }
+
+  if(newest == NO_ENTRY) {
+    head = head_sector = tail = 0;
+    next_seq = 1;
+    return 0;
+  }
+
+  /* The log ends after the last complete entry of the newest sector */
+  head = newest;
+  head_sector = newest;
+  while(sector_start(head) == newest &&
+        (size = read_header(head, hdr)) > 0) {
+    next_seq = get_u32_le(&hdr[4]) + 1;
+    head = skip(head, size);
+  }
+
+  /* Count what is left to replay; the oldest sector follows the newest */
+  tail = NO_ENTRY;
+  offset = next_sector(newest);
+  for(s = 0; s < sectors; s++) {
+    size = count_pending(offset);
+    if(size > 0 && tail == NO_ENTRY) {
+      tail = offset;
+    }
+    stats.pending += size;
+    offset = next_sector(offset);
+  }
+  if(stats.pending == 0) {
+    tail = head;
+  }
+
+  /* Never append after a torn entry: its length cannot be trusted */
+  if(sector_start(head) == newest &&
+     flash->read(head, hdr, 1) == 0 && hdr[0] != 0xff) {
+    return open_sector(next_sector(newest));
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_store_ready(void)
+{
+  return flash != NULL;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_store_put(const struct ber_record *r, uint32_t now)
+{
+  uint8_t entry[BER_STORE_ENTRY_MAX_SIZE];
+  uint32_t size;
+  uint8_t state = BER_STORE_STATE_PENDING;
+
+  if(flash == NULL || r->len > BER_QUEUE_RECORD_SIZE) {
+    return 0;
+  }
+  size = BER_STORE_HEADER_SIZE + r->len;
+
+  /* A sector is erased as the ring reaches it */
+  if(sector_start(head) != head_sector) {
+    if(open_sector(sector_start(head)) != 0) {
+      return 0;
+    }
+  } else if(head % BER_STORE_SECTOR_SIZE + size > BER_STORE_SECTOR_SIZE) {
+    if(open_sector(next_sector(head)) != 0) {
+      return 0;
+    }
+  }
+
+  entry[0] = BER_STORE_MAGIC;
+  entry[1] = BER_STORE_STATE_ERASED;
+  entry[2] = r->len;
+  entry[3] = r->type;
+  put_u32_le(&entry[4], next_seq);
+  put_u32_le(&entry[8], now);
+  put_u32_le(&entry[12], r->present);
+  memcpy(&entry[16], r->addr, sizeof(r->addr));
+#if BER_TIME
+  put_u32_le(&entry[32], (uint32_t)r->asn);
+  put_u32_le(&entry[36], (uint32_t)(r->asn >> 32));
+#else
+  memset(&entry[32], 0, 8);
+#endif
+  memcpy(&entry[BER_STORE_HEADER_SIZE], r->data, r->len);
+
+  /* Program the entry, then commit it by clearing bits of its state */
+  if(flash->write(head, entry, size) != 0 ||
+     flash->write(head + 1, &state, 1) != 0) {
+    stats.errors++;
+    head = skip(head, size);
+    return 0;
+  }
+
+  next_seq++;
+  head = skip(head, size);
+  stats.stored++;
+  stats.pending++;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_store_peek(struct ber_record *r, uint32_t *seq, uint32_t *stored_at)
+{
+  uint8_t hdr[BER_STORE_HEADER_SIZE];
+  uint32_t size;
+  uint32_t next;
+  uint32_t laps;
+
+  if(flash == NULL || stats.pending == 0) {
+    return 0;
+  }
+
+  /* Pending entries lie ahead of tail, so at most one lap is needed */
+  for(laps = 0; laps <= sectors;) {
+    if((size = read_header(tail, hdr)) == 0) {
+      tail = next_sector(tail);
+      laps++;
+      continue;
+    }
+    if(hdr[1] != BER_STORE_STATE_PENDING) {
+      next = skip(tail, size);
+      if(sector_start(next) != sector_start(tail)) {
+        laps++;
+      }
+      tail = next;
+      continue;
+    }
+    if(flash->read(tail + BER_STORE_HEADER_SIZE, r->data, hdr[2]) != 0) {
+      stats.errors++;
+      return 0;
+    }
+    r->len = hdr[2];
+    r->type = hdr[3];
+    r->present = get_u32_le(&hdr[12]);
+    memcpy(r->addr, &hdr[16], sizeof(r->addr));
+#if BER_TIME
+    r->asn = get_u32_le(&hdr[32]) | ((uint64_t)get_u32_le(&hdr[36]) << 32);
+#endif
+    *seq = get_u32_le(&hdr[4]);
+    *stored_at = get_u32_le(&hdr[8]);
+    peeked = tail;
+    return 1;
+  }
+
+  /* The count was off, e.g. after a failed write */
+  stats.pending = 0;
+  tail = head;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_store_pop(void)
+{
+  uint8_t hdr[BER_STORE_HEADER_SIZE];
+  uint8_t state = BER_STORE_STATE_FORWARDED;
+  uint32_t size;
+
+  if(flash == NULL || peeked == NO_ENTRY) {
+    return;
+  }
+  if(flash->write(peeked + 1, &state, 1) != 0) {
+    stats.errors++;
+  }
+  size = read_header(peeked, hdr);
+  tail = size > 0 ? skip(peeked, size) : next_sector(peeked);
+  peeked = NO_ENTRY;
+  stats.pending--;
+  stats.replayed++;
+  if(stats.pending == 0) {
+    tail = head;
+  }
+}
+/*---------------------------------------------------------------------------*/
+const struct ber_store_stats *
+ber_store_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
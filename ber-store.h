@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Store-and-forward of BER records on flash.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Records that cannot go to the UART, because the host is down or
+ *         the output queue is backing up, are appended to a circular log in
+ *         flash and replayed, oldest first, once the host is back.
+ *
+ *         The region is a ring of erase sectors. Each sector holds whole
+ *         entries, written back to back from its start:
+ *
+ *         | offset | size | content                                  |
+ *         |--------|------|------------------------------------------|
+ *         | 0      | 1    | BER_STORE_MAGIC                          |
+ *         | 1      | 1    | state (BER_STORE_STATE_*)                |
+ *         | 2      | 1    | record length N                          |
+ *         | 3      | 1    | record type (BER_FRAME_TYPE_*)           |
+ *         | 4      | 4    | store sequence number, little-endian     |
+ *         | 8      | 4    | uptime when stored in seconds, LE        |
+ *         | 12     | 4    | presence bitmap, little-endian           |
+ *         | 16     | 16   | sender IPv6 address                      |
+ *         | 32     | 8    | reception time in slots, LE (ber-time.h) |
+ *         | 40     | N    | record data                              |
+ *
+ *         Entries are only ever programmed, never rewritten: an entry is
+ *         committed and later marked forwarded by clearing bits of its state
+ *         byte, so the log survives a reset at any point and a sector is
+ *         erased only when the ring wraps onto it. Records still pending in
+ *         that sector are lost and counted as overwritten.
+ *
+ *         The flash itself is reached through struct ber_store_flash, so the
+ *         same log runs on the LaunchPad's SPI flash, on a file for the
+ *         native target, and in host tools.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_STORE_H_
+#define BER_STORE_H_
+
+#include "ber-conf.h"
+#include "ber-queue.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef BER_STORE_CONF_SECTOR_SIZE
+#define BER_STORE_SECTOR_SIZE BER_STORE_CONF_SECTOR_SIZE
+#else
+#define BER_STORE_SECTOR_SIZE 4096
+#endif
+
+#define BER_STORE_MAGIC       0xB6 /* 0xB5 logs had no reception time */
+#define BER_STORE_HEADER_SIZE 40
+#define BER_STORE_ENTRY_MAX_SIZE (BER_STORE_HEADER_SIZE + BER_QUEUE_RECORD_SIZE)
+
+/* Entry states, each one clears more bits of the erased 0xFF */
+#define BER_STORE_STATE_ERASED    0xFF /* Torn write, never committed */
+#define BER_STORE_STATE_PENDING   0x7F /* Committed, not yet replayed */
+#define BER_STORE_STATE_FORWARDED 0x3F /* Replayed to the host */
+
+/** \brief Flash access; all functions return 0 on success */
+struct ber_store_flash {
+  uint32_t size;  /* Region size in bytes, a multiple of the sector size */
+  int (*read)(uint32_t offset, uint8_t *buf, size_t len);
+  int (*write)(uint32_t offset, const uint8_t *buf, size_t len);
+  int (*erase)(uint32_t offset, size_t len);  /* Whole sectors, to 0xFF */
+};
+
+/** \brief Store counters */
+struct ber_store_stats {
+  uint32_t pending;      /* Records waiting to be replayed */
+  uint32_t stored;
+  uint32_t replayed;
+  uint32_t overwritten;  /* Pending records lost to a wrapping ring */
+  uint32_t errors;       /* Failed flash operations */
+};
+
+/**
+ * \brief Open the log, recovering the records left by an earlier run
+ * \param flash The flash region; NULL disables the store
+ * \return 0 on success, -1 if the region is unusable
+ */
+int ber_store_init(const struct ber_store_flash *flash);
+
+/**
+ * \brief Whether ber_store_init() succeeded
+ */
+int ber_store_ready(void);
+
+/**
+ * \brief Append a record to the log
+ * \param r The record
+ * \param now Current uptime in seconds, kept with the record
+ * \return 1 if stored, 0 on error
+ */
+int ber_store_put(const struct ber_record *r, uint32_t now);
+
+/**
+ * \brief Read the oldest pending record without removing it
+ * \param r Filled in with the record
+ * \param seq Filled in with its store sequence number
+ * \param stored_at Filled in with the uptime it was stored at
+ * \return 1 if a record was read, 0 if none is pending
+ */
+int ber_store_peek(struct ber_record *r, uint32_t *seq, uint32_t *stored_at);
+
+/**
+ * \brief Mark the record returned by ber_store_peek() as forwarded
+ */
+void ber_store_pop(void);
+
+/**
+ * \brief Get the store counters
+ */
+const struct ber_store_stats *ber_store_get_stats(void);
+
+/**
+ * \brief The flash region of the platform the BER runs on
+ * \return The region, or NULL if the platform has none
+ */
+const struct ber_store_flash *ber_store_platform_flash(void);
+
+#endif /* BER_STORE_H_ */
+
+/** @} */
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Windowed summaries of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-summary.h"
+#include "ber-wire.h"
+#include <stddef.h>
+#include <string.h>
+
+#define BYTES_PER_INT 4
+
+static const char *const stat_names[BER_SUMMARY_STATS] = {
+  "min", "max", "mean", "sd"
+};
+
+#if BER_SUMMARY
+/** \brief A field that sends its record raw outside [low, high] */
+struct threshold {
+  uint8_t type;
+  const char *field;
+  int32_t low;
+  int32_t high;
+};
+
+#define THRESHOLD(type, field, low, high) { type, field, low, high },
+
+static const struct threshold thresholds[] = {
+  BER_SUMMARY_THRESHOLDS(THRESHOLD)
+  { 0, NULL, 0, 0 }
+};
+
+#define THRESHOLD_COUNT (sizeof(thresholds) / sizeof(thresholds[0]) - 1)
+
+/* Field index + 1 of each threshold once looked up, -1 if there is none */
+static int8_t threshold_field[THRESHOLD_COUNT + 1];
+
+static struct ber_summary slots[BER_SUMMARY_SLOTS];
+static uint8_t enabled = 1;
+#endif /* BER_SUMMARY */
+
+static struct ber_summary_stats stats;
+
+/*---------------------------------------------------------------------------*/
+#if BER_SUMMARY
+static int32_t
+clamp32(int64_t v)
+{
+  return v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : (int32_t)v;
+}
+/*---------------------------------------------------------------------------*/
+/* The value of a field in its fixed point, whatever its encoding */
+static int32_t
+field_fixed(const struct ber_field *f, const uint8_t *data)
+{
+  int32_t ipart = ber_schema_field_value(f, data);
+  int32_t frac;
+  uint32_t m;
+  int64_t v;
+
+  if(f->kind != BER_FIELD_SPLIT) {
+    return ipart;
+  }
+  /* The fraction has at least precision digits, see ber_json_split() */
+  frac = ber_schema_field_value(f, data + BYTES_PER_INT);
+  m = frac < 0 ? -(uint32_t)frac : (uint32_t)frac;
+  while(m >= (uint32_t)f->scale) {
+    m /= 10;
+  }
+  v = (int64_t)(ipart < 0 ? -(int64_t)ipart : ipart) * f->scale + m;
+  return clamp32(ipart < 0 || frac < 0 ? -v : v);
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_i32_le(uint8_t *buf, int32_t v)
+{
+  uint32_t u = (uint32_t)v;
+
+  buf[0] = u & 0xff;
+  buf[1] = (u >> 8) & 0xff;
+  buf[2] = (u >> 16) & 0xff;
+  buf[3] = (u >> 24) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+/* Store a fixed-point value back in the encoding of its field */
+static void
+field_put(const struct ber_field *f, uint8_t *data, int32_t v)
+{
+  if(f->kind != BER_FIELD_SPLIT) {
+    put_i32_le(&data[f->offset], v);
+    return;
+  }
+  put_i32_le(&data[f->offset], v / f->scale);
+  put_i32_le(&data[f->offset + BYTES_PER_INT], v % f->scale);
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+isqrt64(uint64_t v)
+{
+  uint64_t root = 0;
+  uint64_t bit = 1ULL << 62;
+
+  while(bit > v) {
+    bit >>= 2;
+  }
+  while(bit != 0) {
+    if(v >= root + bit) {
+      v -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
+/*---------------------------------------------------------------------------*/
+static int
+over_threshold(const struct ber_payload_type *type, const uint8_t *data,
+               uint32_t present)
+{
+  const struct threshold *t;
+  int32_t v;
+  uint8_t i;
+  uint8_t f;
+
+  for(i = 0; i < THRESHOLD_COUNT; i++) {
+    t = &thresholds[i];
+    if(t->type != type->type) {
+      continue;
+    }
+    if(threshold_field[i] == 0) {
+      threshold_field[i] = -1;
+      for(f = 0; f < type->field_count; f++) {
+        if(!strcmp(type->fields[f].name, t->field)) {
+          threshold_field[i] = f + 1;
+          break;
+        }
+      }
+    }
+    if(threshold_field[i] < 0 ||
+       !(present & (1UL << (threshold_field[i] - 1)))) {
+      continue;
+    }
+    v = field_fixed(&type->fields[threshold_field[i] - 1], data);
+    if(v < t->low || v > t->high) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static struct ber_summary *
+find_slot(const uint8_t *addr, uint8_t type)
+{
+  struct ber_summary *free_slot = NULL;
+
+  for(uint8_t i = 0; i < BER_SUMMARY_SLOTS; i++) {
+    if(slots[i].type == type && !memcmp(slots[i].addr, addr, 16)) {
+      return &slots[i];
+    }
+    if(slots[i].type == 0 && free_slot == NULL) {
+      free_slot = &slots[i];
+    }
+  }
+  if(free_slot != NULL) {
+    memset(free_slot, 0, sizeof(*free_slot));
+    memcpy(free_slot->addr, addr, 16);
+    free_slot->type = type;
+#if BER_TIME
+    free_slot->asn = ber_time_now();
+#endif
+  }
+  return free_slot;
+}
+#endif /* BER_SUMMARY */
+/*---------------------------------------------------------------------------*/
+int
+ber_summary_add(const uint8_t *addr, const struct ber_payload_type *type,
+                const uint8_t *data, uint32_t present)
+{
+#if BER_SUMMARY
+  struct ber_summary *s;
+  int32_t v;
+  int64_t d;
+  uint64_t m;
+  int raw;
+
+  /* A package_number has no min, max or mean worth writing */
+  if(type->seq_field >= 0) {
+    present &= ~(1UL << type->seq_field);
+  }
+
+  if(!enabled || type->field_count == 0 ||
+     type->field_count > BER_SUMMARY_MAX_FIELDS) {
+    return 1;
+  }
+  s = find_slot(addr, type->type);
+  if(s == NULL || s->records == UINT16_MAX) {
+    stats.no_slot++;
+    return 1;
+  }
+
+  for(uint8_t i = 0; i < type->field_count; i++) {
+    if(!(present & (1UL << i))) {
+      continue;
+    }
+    v = field_fixed(&type->fields[i], data);
+    if(s->count[i] == 0) {
+      s->ref[i] = v;
+      s->min[i] = v;
+      s->max[i] = v;
+    } else if(v < s->min[i]) {
+      s->min[i] = v;
+    } else if(v > s->max[i]) {
+      s->max[i] = v;
+    }
+    d = (int64_t)v - s->ref[i];
+    m = d < 0 ? (uint64_t)-d : (uint64_t)d;
+    s->sum[i] += d;
+    s->sumsq[i] += m * m;
+    s->count[i]++;
+  }
+  s->records++;
+  s->present |= present;
+  stats.summarized++;
+
+  raw = over_threshold(type, data, present);
+  stats.over_threshold += raw;
+  return raw;
+#else
+  return 1;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+const struct ber_summary *
+ber_summary_get(uint8_t index)
+{
+#if BER_SUMMARY
+  return index < BER_SUMMARY_SLOTS && slots[index].type != 0 ?
+    &slots[index] : NULL;
+#else
+  return NULL;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_summary_payload(const struct ber_summary *s, uint8_t stat, uint8_t *buf)
+{
+#if BER_SUMMARY
+  const struct ber_payload_type *type = ber_schema_get(s->type);
+  uint8_t *data = &buf[BER_SUMMARY_HEADER_SIZE];
+  uint8_t len = BER_SUMMARY_HEADER_SIZE + type->length;
+  uint64_t sum;
+  uint64_t q;
+  uint64_t sq;
+  uint16_t n;
+  int32_t v;
+
+  buf[0] = s->type;
+  buf[1] = stat;
+  buf[2] = s->records & 0xff;
+  buf[3] = s->records >> 8;
+  memset(data, 0, type->length);
+  for(uint8_t i = 0; i < type->field_count; i++) {
+    n = s->count[i];
+    if(n == 0) {
+      continue;
+    }
+    sum = s->sum[i] < 0 ? -(uint64_t)s->sum[i] : (uint64_t)s->sum[i];
+    switch(stat) {
+    case BER_SUMMARY_MIN:
+      v = s->min[i];
+      break;
+    case BER_SUMMARY_MAX:
+      v = s->max[i];
+      break;
+    case BER_SUMMARY_MEAN:
+      /* Rounded to the nearest unit of the fixed point */
+      q = (sum + n / 2) / n;
+      v = clamp32((int64_t)s->ref[i] +
+                  (s->sum[i] < 0 ? -(int64_t)q : (int64_t)q));
+      break;
+    default:
+      /* sum^2 / n without forming sum^2, which could overflow */
+      q = sum / n;
+      sq = q * q * n + 2 * q * (sum % n) + (sum % n) * (sum % n) / n;
+      v = s->sumsq[i] > sq ? clamp32(isqrt64((s->sumsq[i] - sq) / n)) : 0;
+      break;
+    }
+    field_put(&type->fields[i], data, v);
+  }
+
+  /* Fields no record had are left out, as in record frames */
+  if(s->present != BER_SCHEMA_ALL_FIELDS) {
+    for(uint8_t i = 0; i < BER_WIRE_MASK_SIZE(type); i++) {
+      buf[len++] = s->present >> (8 * i);
+    }
+  }
+  return len;
+#else
+  return 0;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_summary_write_json(struct ber_json *w, const uint8_t *payload,
+                       uint16_t len, const char *key, const char *value,
+                       const uint64_t *asn)
+{
+  const struct ber_payload_type *type;
+  uint32_t present = BER_SCHEMA_ALL_FIELDS;
+
+  if(len < BER_SUMMARY_HEADER_SIZE ||
+     (type = ber_schema_get(payload[0])) == NULL ||
+     type->type >= BER_FRAME_TYPE_INTERNAL || type->field_count == 0 ||
+     payload[1] >= BER_SUMMARY_STATS) {
+    return -1;
+  }
+  len -= BER_SUMMARY_HEADER_SIZE;
+  if(len == type->length + BER_WIRE_MASK_SIZE(type)) {
+    present = 0;
+    for(uint8_t i = 0; i < BER_WIRE_MASK_SIZE(type); i++) {
+      present |= (uint32_t)payload[BER_SUMMARY_HEADER_SIZE + type->length + i]
+        << (8 * i);
+    }
+  } else if(len != type->length) {
+    return -1;
+  }
+
+  ber_json_object_begin(w);
+  ber_json_member_str(w, key, value);
+  if(asn != NULL) {
+    ber_json_member(w, "asn");
+    ber_json_uint64(w, *asn);
+  }
+  ber_json_member_str(w, "stat", ber_summary_stat_name(payload[1]));
+  ber_json_member(w, "records");
+  ber_json_uint(w, payload[2] | ((uint32_t)payload[3] << 8));
+  ber_schema_write_json_fields(w, type, &payload[BER_SUMMARY_HEADER_SIZE],
+                               present);
+  ber_json_object_end(w);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_summary_clear(uint8_t index)
+{
+#if BER_SUMMARY
+  if(index < BER_SUMMARY_SLOTS && slots[index].type != 0) {
+    slots[index].type = 0;
+    stats.windows++;
+  }
+#endif
+}
+/*---------------------------------------------------------------------------*/
+const char *
+ber_summary_stat_name(uint8_t stat)
+{
+  return stat < BER_SUMMARY_STATS ? stat_names[stat] : "unknown";
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_summary_set_enabled(uint8_t on)
+{
+#if BER_SUMMARY
+  enabled = on;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_summary_get_enabled(void)
+{
+#if BER_SUMMARY
+  return enabled;
+#else
+  return 0;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+const struct ber_summary_stats *
+ber_summary_get_stats(void)
+{
+  return &stats;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Windowed summaries of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Instead of forwarding every record, the BER can keep per-window
+ *         statistics of each sensor field and write one summary per node
+ *         and format when the window closes. For every field it keeps the
+ *         count, minimum, maximum, sum and sum of squares of the value in
+ *         its own fixed point (the integer that ber-schema.h scales by
+ *         10^precision), so no floating point is involved.
+ *
+ *         A summary goes out as four records in the layout of the format
+ *         it summarizes, holding the minimum, maximum, mean and standard
+ *         deviation of each field; the output paths and the host decoder
+ *         format them with the same schema as the records themselves.
+ *
+ *         Fields listed in BER_SUMMARY_CONF_THRESHOLDS still let their
+ *         record through raw whenever the value leaves its range, so
+ *         events are not averaged away. Records that find no free slot are
+ *         forwarded raw as well.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_SUMMARY_H_
+#define BER_SUMMARY_H_
+
+#include "ber-conf.h"
+#include "ber-json.h"
+#include "ber-schema.h"
+#include "ber-time.h"
+#include <stdint.h>
+
+#ifdef BER_CONF_SUMMARY
+#define BER_SUMMARY BER_CONF_SUMMARY
+#else
+#define BER_SUMMARY 0
+#endif
+
+/* Node and format pairs summarized at once; each costs 30 bytes per field */
+#ifdef BER_SUMMARY_CONF_SLOTS
+#define BER_SUMMARY_SLOTS BER_SUMMARY_CONF_SLOTS
+#else
+#define BER_SUMMARY_SLOTS 8
+#endif
+
+/* Fields per slot; the IMF4D base board has the most, formats with more
+   are forwarded raw */
+#ifdef BER_SUMMARY_CONF_MAX_FIELDS
+#define BER_SUMMARY_MAX_FIELDS BER_SUMMARY_CONF_MAX_FIELDS
+#else
+#define BER_SUMMARY_MAX_FIELDS 19
+#endif
+
+/*
+ * Fields whose records also go out raw while the value is outside a range,
+ * as X(BER_FRAME_TYPE_*, "field", low, high). The bounds are in the fixed
+ * point of the field, e.g. hundredths of a degree for a precision of 2:
+ *
+ * #define BER_SUMMARY_CONF_THRESHOLDS(X) \
+ *   X(BER_FRAME_TYPE_IMF4D, "hdc_2010_u13_temperature", 0, 4000)
+ */
+#ifdef BER_SUMMARY_CONF_THRESHOLDS
+#define BER_SUMMARY_THRESHOLDS BER_SUMMARY_CONF_THRESHOLDS
+#else
+#define BER_SUMMARY_THRESHOLDS(X)
+#endif
+
+/* The records of a summary, in output order */
+#define BER_SUMMARY_MIN   0
+#define BER_SUMMARY_MAX   1
+#define BER_SUMMARY_MEAN  2
+#define BER_SUMMARY_SD    3 /* Population standard deviation */
+#define BER_SUMMARY_STATS 4
+
+/* Header of a SUMMARY frame payload, followed by the record data and, if
+   not all fields were seen, the presence bitmap as in record frames:
+   format type, statistic, then the number of records as uint16 LE */
+#define BER_SUMMARY_HEADER_SIZE 4
+
+/** \brief The window of one node and format */
+struct ber_summary {
+  uint8_t addr[16];
+  uint8_t type;       /* BER_FRAME_TYPE_*, 0 for a free slot */
+  uint16_t records;   /* Records summarized */
+  uint32_t present;   /* Fields seen in any of them */
+#if BER_TIME
+  uint64_t asn;       /* Reception time of the first one */
+#endif
+  uint16_t count[BER_SUMMARY_MAX_FIELDS];
+  int32_t ref[BER_SUMMARY_MAX_FIELDS];  /* First value, the sums are relative
+                                           to it to keep them small */
+  int32_t min[BER_SUMMARY_MAX_FIELDS];
+  int32_t max[BER_SUMMARY_MAX_FIELDS];
+  int64_t sum[BER_SUMMARY_MAX_FIELDS];
+  uint64_t sumsq[BER_SUMMARY_MAX_FIELDS];
+};
+
+/** \brief Counters, see ber_summary_get_stats() */
+struct ber_summary_stats {
+  uint32_t summarized;      /* Records taken into a window */
+  uint32_t over_threshold;  /* Of those, also forwarded raw */
+  uint32_t no_slot;         /* Forwarded raw, every slot was taken */
+  uint32_t windows;         /* Summaries written */
+};
+
+/**
+ * \brief Take a record into the window of its node
+ * \param addr 16-byte sender address
+ * \param type The payload type of \p data
+ * \param data The record, type->length bytes
+ * \param present Fields present, bit i for field i
+ * \return 1 if the record must still be forwarded raw (a threshold was
+ *         crossed, no slot was free, or the format has no fields), 0 if
+ *         the summary has taken it
+ */
+int ber_summary_add(const uint8_t *addr, const struct ber_payload_type *type,
+                    const uint8_t *data, uint32_t present);
+
+/**
+ * \brief Get a slot by index, for iteration
+ * \param index 0 to BER_SUMMARY_SLOTS - 1
+ * \return The slot, or NULL if it is free
+ */
+const struct ber_summary *ber_summary_get(uint8_t index);
+
+/**
+ * \brief Build the SUMMARY frame payload of one statistic
+ * \param s The slot
+ * \param stat One of BER_SUMMARY_MIN to BER_SUMMARY_SD
+ * \param buf Output, at least BER_SUMMARY_HEADER_SIZE + the record length
+ *            + 4 bytes
+ * \return The payload length
+ */
+uint8_t ber_summary_payload(const struct ber_summary *s, uint8_t stat,
+                            uint8_t *buf);
+
+/**
+ * \brief Append a SUMMARY payload as a bare JSON object to a writer
+ *
+ *        Used by the firmware and by the host decoder alike, so both print
+ *        the same text.
+ * \param w The writer
+ * \param payload As built by ber_summary_payload()
+ * \param len Payload length
+ * \param key Name of the first member, "ipv6" for nodes
+ * \param value Its value, printed as a JSON string
+ * \param asn Reception time of the first record, or NULL
+ * \return 0, or -1 if the payload is malformed and nothing was written
+ */
+int ber_summary_write_json(struct ber_json *w, const uint8_t *payload,
+                           uint16_t len, const char *key, const char *value,
+                           const uint64_t *asn);
+
+/**
+ * \brief Free a slot once its summary has been written
+ * \param index 0 to BER_SUMMARY_SLOTS - 1
+ */
+void ber_summary_clear(uint8_t index);
+
+/**
+ * \brief Name of a statistic, as printed in SUMMARY records
+ * \param stat One of BER_SUMMARY_MIN to BER_SUMMARY_SD
+ */
+const char *ber_summary_stat_name(uint8_t stat);
+
+/**
+ * \brief Turn summarizing on or off; records go out raw while it is off
+ * \param enabled Non-zero to summarize
+ */
+void ber_summary_set_enabled(uint8_t enabled);
+
+/**
+ * \brief Whether records are summarized; always 0 without BER_CONF_SUMMARY
+ */
+uint8_t ber_summary_get_enabled(void);
+
+/**
+ * \brief Get the counters
+ */
+const struct ber_summary_stats *ber_summary_get_stats(void);
+
+#endif /* BER_SUMMARY_H_ */
+
+/** @} */
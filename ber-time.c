@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Network time of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-time.h"
+#include <stddef.h>
+#ifdef CONTIKI
+#include "sys/clock.h"
+#if MAC_CONF_WITH_TSCH
+#include "net/mac/tsch/tsch.h"
+#endif
+#else
+#include <time.h>
+#endif
+
+#if defined(CONTIKI) && MAC_CONF_WITH_TSCH
+#define TIME_SOURCE BER_TIME_SOURCE_TSCH
+#else
+#define TIME_SOURCE BER_TIME_SOURCE_CLOCK
+#endif
+
+#ifndef CONTIKI
+static uint64_t (*host_clock)(void);
+#endif
+
+/*---------------------------------------------------------------------------*/
+#ifndef CONTIKI
+void
+ber_time_set_clock(uint64_t (*now)(void))
+{
+  host_clock = now;
+}
+#endif
+/*---------------------------------------------------------------------------*/
+uint64_t
+ber_time_now(void)
+{
+#if defined(CONTIKI) && MAC_CONF_WITH_TSCH
+  return ((uint64_t)tsch_current_asn.ms1b << 32) | tsch_current_asn.ls4b;
+#elif defined(CONTIKI)
+  return (uint64_t)clock_time() * (1000000 / BER_TIME_CLOCK_SLOT_US) /
+    CLOCK_SECOND;
+#else
+  struct timespec ts;
+
+  if(host_clock != NULL) {
+    return host_clock();
+  }
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000) /
+    BER_TIME_CLOCK_SLOT_US;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+uint32_t
+ber_time_slot_us(void)
+{
+#if defined(CONTIKI) && MAC_CONF_WITH_TSCH
+  return tsch_timing_us[tsch_ts_timeslot_length];
+#else
+  return BER_TIME_CLOCK_SLOT_US;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+ber_time_source(void)
+{
+  return TIME_SOURCE;
+}
+/*---------------------------------------------------------------------------*/
+const char *
+ber_time_source_name(uint8_t source)
+{
+  switch(source) {
+  case BER_TIME_SOURCE_TSCH:
+    return "tsch";
+  case BER_TIME_SOURCE_CLOCK:
+    return "clock";
+  default:
+    return "?";
+  }
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Network time of the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Records are stamped with the time they were received, as a count
+ *         of timeslots. The BER is the TSCH coordinator, so this is the
+ *         absolute slot number (ASN) of the network, which every node
+ *         shares. Builds without TSCH, such as the native target, and host
+ *         tools count BER_TIME_CLOCK_SLOT_US slots of the system clock
+ *         instead.
+ *
+ *         The stamp is taken when a datagram is queued, so the time a
+ *         record then spends in the queue, in a batch or in flash does not
+ *         show in it. Anchor records (ber_record_anchor()) carry the current
+ *         ASN and the slot length, which is all the host needs to turn the
+ *         stamps into wall-clock time.
+ *
+ *         This file has no Contiki dependencies beyond the clock and TSCH,
+ *         so that host tools can share it with the firmware.
+ * @{
+ */
+#ifndef BER_TIME_H_
+#define BER_TIME_H_
+
+#include "ber-conf.h"
+#include <stdint.h>
+
+#ifdef BER_CONF_TIME
+#define BER_TIME BER_CONF_TIME
+#else
+#define BER_TIME 0
+#endif
+
+/* Slot length when there is no TSCH to take it from */
+#ifdef BER_TIME_CONF_CLOCK_SLOT_US
+#define BER_TIME_CLOCK_SLOT_US BER_TIME_CONF_CLOCK_SLOT_US
+#else
+#define BER_TIME_CLOCK_SLOT_US 10000
+#endif
+
+/* Where the slot count comes from, see ber_time_source() */
+#define BER_TIME_SOURCE_TSCH  0 /* The ASN */
+#define BER_TIME_SOURCE_CLOCK 1 /* The system clock since boot */
+
+/**
+ * \brief Current time in slots
+ */
+uint64_t ber_time_now(void);
+
+/**
+ * \brief Length of a slot in microseconds
+ */
+uint32_t ber_time_slot_us(void);
+
+/**
+ * \brief Where ber_time_now() comes from
+ * \return One of BER_TIME_SOURCE_*
+ */
+uint8_t ber_time_source(void);
+
+/**
+ * \brief Name of a time source, as written in anchor records
+ * \param source One of BER_TIME_SOURCE_*
+ * \return "tsch", "clock", or "?" if unknown
+ */
+const char *ber_time_source_name(uint8_t source);
+
+#ifndef CONTIKI
+/**
+ * \brief Replace the host clock, e.g. with the simulated time of a benchmark
+ * \param now The clock, in slots; NULL restores the monotonic clock
+ */
+void ber_time_set_clock(uint64_t (*now)(void));
+#endif
+
+#endif /* BER_TIME_H_ */
+
+/** @} */
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Datagram formats sent by sensor nodes to the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * @{
+ */
+#include "ber-wire.h"
+#include <string.h>
+
+#define BYTES_PER_INT 4
+#define VARINT_MAX_SIZE 5
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+get_le32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+    ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_le32(uint8_t *p, uint32_t v)
+{
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+/*---------------------------------------------------------------------------*/
+/* One zigzag varint; returns the number of bytes read, 0 if malformed */
+static uint8_t
+read_varint(const uint8_t *p, const uint8_t *end, uint32_t *v)
+{
+  uint32_t u = 0;
+  uint8_t i;
+
+  for(i = 0; i < VARINT_MAX_SIZE && p + i < end; i++) {
+    u |= (uint32_t)(p[i] & 0x7f) << (7 * i);
+    if(!(p[i] & 0x80)) {
+      *v = (u >> 1) ^ -(u & 1);
+      return i + 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+decode_words(const struct ber_payload_type *t, uint8_t version,
+             const uint8_t *p, const uint8_t *end, uint8_t *out,
+             uint32_t present)
+{
+  uint8_t words;
+  uint8_t *o;
+  uint32_t v;
+  uint8_t n;
+
+  for(uint8_t i = 0; i < t->field_count; i++) {
+    if(!(present & (1UL << i))) {
+      continue;
+    }
+    words = t->fields[i].kind == BER_FIELD_SPLIT ? 2 : 1;
+    o = &out[t->fields[i].offset];
+    for(; words > 0; words--, o += BYTES_PER_INT) {
+      if(version == BER_WIRE_VERSION_SPARSE) {
+        if(end - p < BYTES_PER_INT) {
+          return -1;
+        }
+        memcpy(o, p, BYTES_PER_INT);
+        p += BYTES_PER_INT;
+        continue;
+      }
+      if((n = read_varint(p, end, &v)) == 0) {
+        return -1;
+      }
+      p += n;
+      if(version == BER_WIRE_VERSION_DELTA) {
+        v += get_le32(o);
+      }
+      put_le32(o, v);
+    }
+  }
+  return p == end ? 0 : -1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+decode_header(const uint8_t *data, uint16_t len,
+              const struct ber_wire_state *ref, uint8_t *out,
+              size_t out_size, const struct ber_payload_type **type,
+              uint32_t *present)
+{
+  const struct ber_payload_type *t;
+  const uint8_t *p = &data[BER_WIRE_HEADER_SIZE];
+  const uint8_t *end = data + len;
+  uint8_t version = data[1] >> 4;
+  uint8_t mask_size;
+  uint32_t mask = 0;
+  uint8_t i;
+
+  if(!BER_WIRE_HAS_HEADER(data, len)) {
+    return BER_WIRE_UNKNOWN;
+  }
+  t = ber_schema_get(data[1] & 0x0f);
+  if(t == NULL || t->type >= BER_FRAME_TYPE_INTERNAL || t->length > out_size) {
+    return BER_WIRE_UNKNOWN;
+  }
+
+  if(version == BER_WIRE_VERSION_DELTA) {
+    if(p == end) {
+      return BER_WIRE_UNKNOWN;
+    }
+    if(ref == NULL || ref->type != t->type || ref->seq != *p) {
+      return BER_WIRE_NO_REFERENCE;
+    }
+    p++;
+    memcpy(out, ref->data, t->length);
+  } else {
+    memset(out, 0, t->length);
+  }
+
+  mask_size = BER_WIRE_MASK_SIZE(t);
+  if(end - p < mask_size) {
+    return BER_WIRE_UNKNOWN;
+  }
+  for(i = 0; i < mask_size; i++) {
+    mask |= (uint32_t)*p++ << (8 * i);
+  }
+  if(t->field_count < 32 && (mask >> t->field_count) != 0) {
+    return BER_WIRE_UNKNOWN;
+  }
+
+  if(decode_words(t, version, p, end, out, mask) < 0) {
+    return BER_WIRE_UNKNOWN;
+  }
+  *type = t;
+  *present = mask;
+  return BER_WIRE_HEADER;
+}
+/*---------------------------------------------------------------------------*/
+int
+ber_wire_decode(const uint8_t *data, uint16_t len,
+                const struct ber_wire_state *ref, uint8_t *out,
+                size_t out_size, const struct ber_payload_type **type,
+                uint32_t *present)
+{
+  const struct ber_payload_type *t;
+  int result;
+
+  result = decode_header(data, len, ref, out, out_size, type, present);
+  if(result != BER_WIRE_UNKNOWN) {
+    return result;
+  }
+
+  t = ber_schema_lookup(len);
+  if(t == NULL || t->length > out_size) {
+    return BER_WIRE_UNKNOWN;
+  }
+  memcpy(out, data, t->length);
+  *type = t;
+  *present = BER_SCHEMA_ALL_FIELDS;
+  return BER_WIRE_LEGACY;
+}
+/*---------------------------------------------------------------------------*/
+void
+ber_wire_update(struct ber_wire_state *ref,
+                const struct ber_payload_type *type,
+                const uint8_t *record, uint32_t seq)
+{
+  if(type->length > sizeof(ref->data)) {
+    ref->type = 0;
+    return;
+  }
+  memcpy(ref->data, record, type->length);
+  ref->type = type->type;
+  ref->seq = seq & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Datagram formats sent by sensor nodes to the Base Edge Router (BER).
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Old firmware sends fixed-layout datagrams whose format is known
+ *         only from their length (ber-schema.h). Newer firmware prefixes
+ *         a header:
+ *
+ *         | offset | size | content                                      |
+ *         |--------|------|----------------------------------------------|
+ *         | 0      | 1    | BER_WIRE_MAGIC                               |
+ *         | 1      | 1    | version << 4 \| record type (BER_FRAME_TYPE_*) |
+ *         | 2      | 1    | payload length N                             |
+ *         | 3      | N    | payload, depending on the version            |
+ *
+ *         Every payload has a presence bitmap of (field_count + 7) / 8
+ *         bytes, bit i of byte i / 8 standing for field i of the schema,
+ *         followed by one value per int32 word of each present field (two
+ *         for split fields), in schema order, so a node sends only the
+ *         sensors it has. The versions differ in how the words are coded:
+ *
+ *         - BER_WIRE_VERSION_SPARSE: little-endian int32.
+ *         - BER_WIRE_VERSION_VARINT: zigzag varints (LEB128 of
+ *           (v << 1) ^ (v >> 31)), one byte for values within +-63.
+ *         - BER_WIRE_VERSION_DELTA: a reference byte before the bitmap,
+ *           then zigzag varint differences to the reference record.
+ *
+ *         The reference of a delta is the last record of the same type the
+ *         node sent with a header and a package_number; the reference byte
+ *         is the low byte of that package_number. The BER keeps that record
+ *         per node (struct ber_wire_state) and drops deltas whose reference
+ *         it did not receive, so a lost record never yields wrong values.
+ *         Nodes send a non-delta record (a keyframe) periodically and after
+ *         a record went unacknowledged. Fields absent from a delta keep
+ *         their reference value for the next one.
+ *
+ *         A datagram is taken as headered only if the magic, version, type,
+ *         length byte and bitmap are all consistent; anything else falls
+ *         back to the length-based legacy formats.
+ *
+ *         This file has no Contiki dependencies so that host tools can
+ *         share it with the firmware.
+ * @{
+ */
+#ifndef BER_WIRE_H_
+#define BER_WIRE_H_
+
+#include "ber-conf.h"
+#include "ber-schema.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define BER_WIRE_MAGIC        0xF4
+#define BER_WIRE_HEADER_SIZE  3
+#define BER_WIRE_MASK_SIZE(type) (((type)->field_count + 7) / 8)
+
+/* Payload versions */
+#define BER_WIRE_VERSION_SPARSE 1
+#define BER_WIRE_VERSION_VARINT 2
+#define BER_WIRE_VERSION_DELTA  3
+
+#define BER_WIRE_VERSION_TYPE(version, type) (((version) << 4) | (type))
+
+/* Keep a reference record per node, so that deltas can be decoded */
+#ifdef BER_WIRE_CONF_DELTA
+#define BER_WIRE_DELTA BER_WIRE_CONF_DELTA
+#else
+#define BER_WIRE_DELTA 1
+#endif
+
+/* Largest record that can serve as a reference, the IMF4D format */
+#ifdef BER_WIRE_CONF_STATE_SIZE
+#define BER_WIRE_STATE_SIZE BER_WIRE_CONF_STATE_SIZE
+#else
+#define BER_WIRE_STATE_SIZE 76
+#endif
+
+/* Results of ber_wire_decode() */
+#define BER_WIRE_LEGACY        0
+#define BER_WIRE_HEADER        1
+#define BER_WIRE_UNKNOWN      -1
+#define BER_WIRE_NO_REFERENCE -2
+
+/** \brief The reference record of a node for delta decoding */
+struct ber_wire_state {
+  uint8_t type;   /* BER_FRAME_TYPE_* of the reference, 0 if none */
+  uint8_t seq;    /* Low byte of its package_number */
+  uint8_t data[BER_WIRE_STATE_SIZE];
+};
+
+/**
+ * \brief Whether a datagram starts with a consistent header: magic, version
+ *        and length byte. Length-based rules (energest reports, rate
+ *        classes) only apply to datagrams without one.
+ * \param data Datagram bytes
+ * \param len Datagram length
+ */
+#define BER_WIRE_HAS_HEADER(data, len) \
+  ((len) >= BER_WIRE_HEADER_SIZE && (data)[0] == BER_WIRE_MAGIC && \
+   (data)[2] == (len) - BER_WIRE_HEADER_SIZE && \
+   ((data)[1] >> 4) >= BER_WIRE_VERSION_SPARSE && \
+   ((data)[1] >> 4) <= BER_WIRE_VERSION_DELTA)
+
+/**
+ * \brief Whether a datagram is a delta, i.e. needs the reference of its node
+ * \param data Datagram bytes
+ * \param len Datagram length
+ */
+#define BER_WIRE_IS_DELTA(data, len) \
+  ((len) >= BER_WIRE_HEADER_SIZE && (data)[0] == BER_WIRE_MAGIC && \
+   ((data)[1] >> 4) == BER_WIRE_VERSION_DELTA)
+
+/**
+ * \brief Decode a datagram into the fixed layout of its schema
+ * \param data Datagram bytes
+ * \param len Datagram length
+ * \param ref Reference of the sender for deltas, may be NULL otherwise
+ * \param out Output, receives type->length bytes; absent fields are zero,
+ *        or in a delta their reference value
+ * \param out_size Size of \p out
+ * \param type Set to the payload type
+ * \param present Set to the presence bitmap, BER_SCHEMA_ALL_FIELDS for
+ *        legacy datagrams
+ * \return BER_WIRE_HEADER or BER_WIRE_LEGACY; BER_WIRE_NO_REFERENCE for a
+ *         delta whose reference is not \p ref, BER_WIRE_UNKNOWN if the
+ *         datagram matches no format or does not fit in \p out
+ */
+int ber_wire_decode(const uint8_t *data, uint16_t len,
+                    const struct ber_wire_state *ref, uint8_t *out,
+                    size_t out_size, const struct ber_payload_type **type,
+                    uint32_t *present);
+
+/**
+ * \brief Make a decoded headered record the reference for the next delta
+ * \param ref The state of the sender
+ * \param type The payload type of \p record
+ * \param record The record, as decoded by ber_wire_decode()
+ * \param seq Its package_number
+ */
+void ber_wire_update(struct ber_wire_state *ref,
+                     const struct ber_payload_type *type,
+                     const uint8_t *record, uint32_t seq);
+
+#endif /* BER_WIRE_H_ */
+
+/** @} */
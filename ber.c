@@ -64,397 +64,530 @@
 #include "sys/log.h"
 #include <stdio.h>
 #include "net/ipv6/uip.h"
+#include "ber-record.h"
+#include "ber-summary.h"
+#include "ber-shell.h"
+#include "ber-prof.h"
+#include "ber-ack.h"
+#include "ber-store.h"
+#if BUILD_WITH_ORCHESTRA
+#include "ber-orchestra.h"
+#endif
 
 #define LOG_MODULE "F4D"
 #define LOG_LEVEL LOG_LEVEL_INFO
-#define UDP_SERVER_PORT 1234
-#define UDP_CLIENT_PORT 4321
-#define WITH_SERVER_REPLY  0
 #define BYTES_PER_INT 4
 #define ACK_MSG "ACK"
-#define IMF4D_BASE_SENSORS_COUNT 19
-#define IMF4D_ADVANCED_SENSORS_COUNT 3
-#define BYTES_PER_UINT32 4
-#define ENERGEST_PAYLOAD_BUFFER_SIZE 8  /* Size of the uint32_t array */
-char ipv6_decoded[64];
 
-static struct simple_udp_connection udp_conn;
-static int air_velocity, air_velocity_int, air_velocity_frac;
-uint32_t energest_values_uint32[ENERGEST_PAYLOAD_BUFFER_SIZE];
+/* Batch JSON records for this long before writing them out, 0 disables */
+#ifdef BER_CONF_BATCH_INTERVAL
+#define BER_BATCH_INTERVAL BER_CONF_BATCH_INTERVAL
+#else
+#define BER_BATCH_INTERVAL 0
+#endif
+
+/* Flush a batch early once this many records are waiting */
+#ifdef BER_CONF_BATCH_MAX_RECORDS
+#define BER_BATCH_MAX_RECORDS BER_CONF_BATCH_MAX_RECORDS
+#else
+#define BER_BATCH_MAX_RECORDS (BER_QUEUE_SIZE - BER_QUEUE_SIZE / 4)
+#endif
+
+#if BER_BATCH_MAX_RECORDS > BER_QUEUE_SIZE
+#error "BER_CONF_BATCH_MAX_RECORDS must not exceed BER_QUEUE_CONF_SIZE"
+#endif
+
+/* Write the per-node sequence counters this often, 0 disables */
+#ifdef BER_CONF_NODE_STATS_INTERVAL
+#define BER_NODE_STATS_INTERVAL BER_CONF_NODE_STATS_INTERVAL
+#else
+#define BER_NODE_STATS_INTERVAL 0
+#endif
+
+/* Write the energest duty cycles of all nodes this often, 0 disables */
+#ifdef BER_CONF_ENERGY_INTERVAL
+#define BER_ENERGY_INTERVAL BER_CONF_ENERGY_INTERVAL
+#else
+#define BER_ENERGY_INTERVAL 0
+#endif
+
+/* Write the stage histograms this often, 0 disables; needs BER_CONF_PROF */
+#if defined(BER_CONF_PROF_INTERVAL) && BER_PROF
+#define BER_PROF_INTERVAL BER_CONF_PROF_INTERVAL
+#else
+#define BER_PROF_INTERVAL 0
+#endif
+
+/* How nodes are acknowledged, one of BER_ACK_* (see ber-ack.h) */
+#ifdef BER_CONF_ACK_MODE
+#define BER_ACK_MODE BER_CONF_ACK_MODE
+#else
+#define BER_ACK_MODE BER_ACK_NONE
+#endif
+
+/* Send aggregated ACKs this often */
+#ifdef BER_CONF_ACK_INTERVAL
+#define BER_ACK_INTERVAL BER_CONF_ACK_INTERVAL
+#else
+#define BER_ACK_INTERVAL (30 * CLOCK_SECOND)
+#endif
+
+/* Gap between two ACK datagrams of the same round */
+#ifdef BER_CONF_ACK_SPACING
+#define BER_ACK_SPACING BER_CONF_ACK_SPACING
+#else
+#define BER_ACK_SPACING (CLOCK_SECOND / 4)
+#endif
+
+/* Re-evaluate the uplink cells of the root this often, 0 disables */
+#if defined(BER_CONF_ORCHESTRA_ADAPT_INTERVAL) && BUILD_WITH_ORCHESTRA
+#define BER_ORCHESTRA_ADAPT_INTERVAL BER_CONF_ORCHESTRA_ADAPT_INTERVAL
+#else
+#define BER_ORCHESTRA_ADAPT_INTERVAL 0
+#endif
+
+/* Keep records in flash while the host is away (see ber-store.h) */
+#ifdef BER_CONF_STORE
+#define BER_STORE BER_CONF_STORE
+#else
+#define BER_STORE 0
+#endif
+
+/* The host is down once it has not sent "ber alive" for this long; with 0
+   it is always taken as up, and only queue overflows go to flash */
+#ifdef BER_CONF_STORE_HOST_TIMEOUT
+#define BER_STORE_HOST_TIMEOUT BER_CONF_STORE_HOST_TIMEOUT
+#else
+#define BER_STORE_HOST_TIMEOUT 0
+#endif
+
+/* With the host up, move the oldest record to flash once this many wait */
+#ifdef BER_CONF_STORE_SPILL_LEVEL
+#define BER_STORE_SPILL_LEVEL BER_CONF_STORE_SPILL_LEVEL
+#else
+#define BER_STORE_SPILL_LEVEL BER_QUEUE_SIZE
+#endif
+
+/* Write a time anchor this often, 0 disables; needs BER_CONF_TIME */
+#if !BER_TIME
+#define BER_ANCHOR_INTERVAL 0
+#elif defined(BER_CONF_ANCHOR_INTERVAL)
+#define BER_ANCHOR_INTERVAL BER_CONF_ANCHOR_INTERVAL
+#else
+#define BER_ANCHOR_INTERVAL (60 * CLOCK_SECOND)
+#endif
+
+/* Close the summary window this often; needs BER_CONF_SUMMARY */
+#if !BER_SUMMARY
+#define BER_SUMMARY_INTERVAL 0
+#elif defined(BER_CONF_SUMMARY_INTERVAL)
+#define BER_SUMMARY_INTERVAL BER_CONF_SUMMARY_INTERVAL
+#else
+#define BER_SUMMARY_INTERVAL (15 * 60 * CLOCK_SECOND)
+#endif
+
+/* Also serve nodes that still use BER_UDP_LEGACY_*_PORT (see ber.h) */
+#ifdef BER_CONF_LEGACY_PORTS
+#define BER_LEGACY_PORTS BER_CONF_LEGACY_PORTS
+#else
+#define BER_LEGACY_PORTS 1
+#endif
+
+#define BER_ACK_AGGREGATED \
+  (BER_ACK_MODE == BER_ACK_UNICAST || BER_ACK_MODE == BER_ACK_BROADCAST)
 
-/* Function to translate abbreviated JSON keys to original JSON keys */
-void
-translate_json_keys(const char *input, char *output, const char *ipv6_decoded)
+static struct simple_udp_connection udp_conn;
+#if BER_LEGACY_PORTS
+static struct simple_udp_connection legacy_conn;
+static uint8_t legacy_heard; /* Some node has used the legacy ports */
+#endif
+static uint8_t batch_flush_requested;
+static uint8_t node_stats_requested;
+static uint8_t energy_requested;
+static uint8_t prof_requested;
+static uint8_t anchor_requested;
+static uint8_t summary_requested;
+#if BER_STORE && BER_STORE_HOST_TIMEOUT > 0
+static clock_time_t host_heard;
+static uint8_t host_seen;
+#endif
+
+/* Startup banner; const pointers, so the table costs no RAM */
+static const char *const quotes[] = {
+    "If debugging is the process of removing software bugs, then programming must be the process of putting them in.",
+    "In order to understand recursion, one must first understand recursion.",
+    "There are only two hard things in computer science: cache invalidation and naming things.",
+    "Programming today is a race between software engineers striving to build bigger and better idiot-proof programs, and the Universe trying to produce bigger and better idiots. So far, the Universe is winning.",
+    "Code never lies, comments sometimes do.",
+    "Quality is not an act, it is a habit.",
+    "The strength of JavaScript is that you can do anything. The weakness is that you will.",
+    "A good programmer looks both ways before crossing a one-way street.",
+    "It’s harder to read code than to write it.",
+    "The most important property of a program is whether it accomplishes the intention of its user.",
+    "Programs must be written for people to read, and only incidentally for machines to execute.",
+    "Programming is the art of doing one thing at a time.",
+    "The best code is no code at all.",
+    "Java is to JavaScript what Car is to Carpet.",
+    "Real programmers can write assembly code in any language.",
+    "It’s not about how fast you can code, but how well you can think."
+};
+/*-------------------------------------------------*/
+PROCESS(udp_server_process, "UDP server");
+PROCESS(ber_output_process, "BER output");
+#if BER_ACK_AGGREGATED
+PROCESS(ber_ack_process, "BER ACK");
+#endif
+AUTOSTART_PROCESSES(&udp_server_process);
+/*-------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+                const uip_ipaddr_t *sender_addr,
+                uint16_t sender_port,
+                const uip_ipaddr_t *receiver_addr,
+                uint16_t receiver_port,
+                const uint8_t *data,
+                uint16_t datalen)
 {
-  const char *ptr = input;
-  char *out_ptr = output;
-
-  /* Initialize the buffer with the JSON_START marker and opening brace */
-  strcpy(out_ptr, "\nJSON_START\n");
-  out_ptr += strlen(out_ptr);
-
-  /* Loop through input string */
-  while(*ptr != '\0') {
-    if(*ptr == '\"') {
-      ptr++;       /* Move past the quote */
-      switch(*ptr) {
-      case 'a':
-        strcpy(out_ptr, "\n    \"light\"");
-        break;
-      case 'b':
-        strcpy(out_ptr, "    \"battery\"");
-        break;
-      case 'c':
-        strcpy(out_ptr, "    \"bmp_press\"");
-        break;
-      case 'd':
-        strcpy(out_ptr, "    \"bmp_temp\"");
-        break;
-      case 'e':
-        strcpy(out_ptr, "    \"hdc_temp\"");
-        break;
-      case 'f':
-        strcpy(out_ptr, "    \"hdc_humidity\"");
-        break;
-      case 'g':
-        strcpy(out_ptr, "    \"packet_number\"");
-
-        break;
-      default:
-        out_ptr[0] = '\0';             /* If the key is not recognized */
-        break;
-      }
-      if(out_ptr[0] != '\0') {
-        out_ptr += strlen(out_ptr);
-        while(*ptr != ':') {
-          ptr++;           /* Move past the abbreviated key */
-        }
-      }
-    }
-    *out_ptr++ = *ptr++;     /* Copy the rest of the characters */
-    if(*ptr == ',' || *ptr == '}') {
-      /* Add the necessary comma or closing brace and new line */
-      if(*ptr == ',') {
-        *out_ptr++ = ',';
-        *out_ptr++ = '\n';
-      } else if(*ptr == '}') {
-        ptr++;         /* Move past the closing brace */
-        break;         /* End the loop as we've reached the end of the main JSON object */
-      }
-      ptr++;
-    }
+  /* Only copy the datagram here, ber_output_process does the rest */
+  if(ber_record_input(sender_addr->u8, data, datalen)) {
+    process_poll(&ber_output_process);
   }
 
-  /* Add hardcoded values for battery_t, tmp107_amb, tmp107_obj, and rssi */
-  strcpy(out_ptr, ",\n    \"battery_t\":99,\n");
-  out_ptr += strlen(out_ptr);
-  strcpy(out_ptr, "    \"tmp107_amb\":99.999,\n");
-  out_ptr += strlen(out_ptr);
-  strcpy(out_ptr, "    \"tmp107_obj\":99.999,\n");
-  out_ptr += strlen(out_ptr);
-  strcpy(out_ptr, "    \"rssi\":-99,\n");
-  out_ptr += strlen(out_ptr);
-
-  /* Add the ipv6 key and value last */
-  strcpy(out_ptr, "    \"ipv6\":\"");
-  out_ptr += strlen(out_ptr);
-  strcpy(out_ptr, ipv6_decoded);
-  out_ptr += strlen(out_ptr);
-  strcpy(out_ptr, "\"\n");
-  out_ptr += strlen(out_ptr);
-
-  /* Add JSON_END marker */
-  strcpy(out_ptr, "}\nJSON_END\n");
-  out_ptr += strlen(out_ptr);
-
-  /* Null-terminate the output string */
-  *out_ptr = '\0';
-}
-void
-ip_beautify(const uip_ipaddr_t *addr)
-{
-  char ipv6[64];
-  char str[64];
-  memset(ipv6, '\0', sizeof ipv6);
-  memset(str, '\0', sizeof str);
-  uint16_t a;
-  uint16_t r = 0;
-  int i, f;
-  for(i = 0, f = 0; i < sizeof(uip_ipaddr_t); i += 2) {
-    a = (addr->u8[i] << 8) + addr->u8[i + 1];
-    if(r != a && a != 0) {
-      r = a;
-      sprintf(str, "%x", a);
-      strcat(ipv6, str);
-    }
-    if(a == 0 && f >= 0) {
-      if(f++ == 0) {
-      }
-    } else {
-      if(f > 0) {
-        f = -1;
-      } else if(i > 0) {
-      }
-    }
+#if BER_LEGACY_PORTS
+  if(c == &legacy_conn) {
+    legacy_heard = 1;
   }
-  strcpy(ipv6_decoded, ipv6);
-  memset(ipv6, '\0', sizeof ipv6);
-  memset(str, '\0', sizeof str);
+#if BER_ACK_MODE == BER_ACK_UNICAST
+  /* Aggregated ACKs go back to the port the node sends from */
+  ber_node_lookup(sender_addr->u8)->legacy_port = c == &legacy_conn;
+#endif
+#endif /* BER_LEGACY_PORTS */
+
+#if BER_ACK_MODE == BER_ACK_PER_PACKET
+  /* Send ACK response for successfully processed payload */
+  LOG_INFO("Sending response.\n");
+  uint8_t ack_msg[4] = { 1, 0, 0, 1 };
+  simple_udp_sendto(c, ack_msg, sizeof(ack_msg), sender_addr);
+#endif /* BER_ACK_MODE == BER_ACK_PER_PACKET */
 }
 /*-------------------------------------------------*/
 void
-print_energest_info(const char *label, uint32_t ticks, uint32_t total_ticks)
+ber_host_alive(void)
 {
-  float permil_float = (ticks * 1000.0f) / total_ticks;
-  uint32_t permil = (uint32_t)(permil_float * 100); /* Multiply by 100 to keep two decimal places */
-  printf("[INFO: Energest] %s : %10u/%10u (%u.%02u permil)\n", label, ticks, total_ticks, permil / 100, permil % 100);
+#if BER_STORE && BER_STORE_HOST_TIMEOUT > 0
+  host_heard = clock_time();
+  host_seen = 1;
+#endif
+  /* Replay whatever was stored while it was away */
+  process_poll(&ber_output_process);
 }
 /*-------------------------------------------------*/
-void
-unpack_data_and_print(uint32_t *energest_values, const char *ipv6_decoded)
+int
+ber_host_up(void)
 {
-  printf("\n\rENERGEST_START\n");
-  printf("\n[INFO: Energest] --- Period summary #%u (%u seconds) [\"%s\"]\n",
-         energest_values[7], energest_values[6],
-         ipv6_decoded);   /* Removed strlen usage as it's not needed for "%s" */
-  printf("[INFO: Energest] Total time  :    %u\n", energest_values[5]);
-
-  print_energest_info("CPU", energest_values[0], energest_values[5]);
-  print_energest_info("LPM", energest_values[1], energest_values[5]);
-  print_energest_info("Deep LPM", energest_values[2], energest_values[5]);
-  print_energest_info("Radio Tx", energest_values[3], energest_values[5]);
-  print_energest_info("Radio Rx", energest_values[4], energest_values[5]);
-  printf("\n\rENERGEST_END\n");
-
-  /* JSON output */
-  printf("\n\rENERGEST_JSON_START\n");
-  printf("{\n");
-  printf("  \"ipv6\": \"%s\",\n", ipv6_decoded);
-  printf("  \"cpu\": %u,\n", energest_values[0]);
-  printf("  \"lpm\": %u,\n", energest_values[1]);
-  printf("  \"deep_lpm\": %u,\n", energest_values[2]);
-  printf("  \"radio_tx\": %u,\n", energest_values[3]);
-  printf("  \"radio_rx\": %u,\n", energest_values[4]);
-  printf("  \"total_time\": %u,\n", energest_values[5]);
-  printf("  \"period_count\": %u,\n", energest_values[7]);
-  printf("  \"period_time\": %u\n", energest_values[6]);
-  printf("}\n");
-  printf("\rENERGEST_JSON_END\n");
+#if BER_STORE && BER_STORE_HOST_TIMEOUT > 0
+  return host_seen && clock_time() - host_heard < BER_STORE_HOST_TIMEOUT;
+#else
+  return 1;
+#endif
 }
 /*-------------------------------------------------*/
 void
-print_raw_payload_as_json(const int *payload, int size)
+ber_anchor(void)
 {
-  if(size <= 0 || size > IMF4D_BASE_SENSORS_COUNT) {
-    printf("Invalid payload size.\n");
-    return;
-  }
-
-  printf("{\n");
-  for(int i = 0; i < size; ++i) {
-    printf("    \"%s\": %d", raw_sensor_keys[i], payload[i]);
-    if(i < size - 1) {
-      printf(",\n");
-    } else {
-      printf("\n");
-    }
-  }
-  printf("}\n");
+#if BER_TIME
+  anchor_requested = 1;
+  process_poll(&ber_output_process);
+#endif
 }
 /*-------------------------------------------------*/
-
 void
-print_payload_as_json(const int *payload, int size, const char *ipv6_decoded)
+ber_summary_close(void)
 {
-  printf("\nJSON_START\n{\n");
-  printf("    \"ipv6\":\"%s\",\n", ipv6_decoded);
-
-  for(int i = 0; i < size; i++) {
-    if(strcmp(decimal_sensor_keys[i], "bmp_390_u18_pressure") == 0 ||
-       strcmp(decimal_sensor_keys[i], "bmp_390_u19_pressure") == 0) {
-      /* Apply transformation for bmp_390_u18_pressure and bmp_390_u19_pressure */
-      int integer_part = payload[i] / 10000;
-      int decimal_part = abs(payload[i] % 10000);
-      printf("    \"%s\":%d.%04d", decimal_sensor_keys[i], integer_part, decimal_part);
-    } else if(strcmp(decimal_sensor_keys[i], "batmon_battery_voltage") == 0 ||
-              strcmp(decimal_sensor_keys[i], "batmon_temperature") == 0 ||
-              strcmp(decimal_sensor_keys[i], "package_number") == 0 ||
-              strcmp(decimal_sensor_keys[i], "rssi") == 0) {
-      /* Print these values as integers without decimal transformation */
-      printf("    \"%s\":%d", decimal_sensor_keys[i], payload[i]);
-    } else if(strcmp(decimal_sensor_keys[i], "air_velocity") == 0) {
-      /* Special handling for air_velocity */
-      int integer_part = payload[i] / 100000;
-      int decimal_part = abs(payload[i] % 100000);
-      printf("    \"%s\":%d.%05d", decimal_sensor_keys[i], integer_part, decimal_part);
-    } else {
-      /* For other sensors, apply the decimal transformation */
-      int integer_part = payload[i] / 100;
-      int decimal_part = abs(payload[i] % 100);
-      printf("    \"%s\":%d.%02d", decimal_sensor_keys[i], integer_part, decimal_part);
-    }
-    if(i < size - 1) {
-      printf(",\n");
-    } else {
-      printf("\n");
-    }
-  }
-  printf("}\nJSON_END\n");
+#if BER_SUMMARY
+  summary_requested = 1;
+  process_poll(&ber_output_process);
+#endif
 }
 /*-------------------------------------------------*/
-// int
-// bytes_to_int(const uint8_t *bytes)
-// {
-//   return (int)bytes[0] | ((int)bytes[1] << 8) | ((int)bytes[2] << 16) | ((int)bytes[3] << 24);
-// }
-int bytes_to_int(const uint8_t *bytes) {
-  return (int)(bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24));
-}
-/*-------------------------------------------------*/
-
-static void
-bytes_to_uint32(const uint8_t *bytes, uint32_t *num)
+/* Nobody is reading, or the UART cannot keep up: keep the record for later */
+static int
+store_record(const struct ber_record *r)
 {
-  *num = ((uint32_t)bytes[0] << 24) |
-    ((uint32_t)bytes[1] << 16) |
-    ((uint32_t)bytes[2] << 8) |
-    (uint32_t)bytes[3];
+#if BER_STORE
+  if(ber_host_up() && ber_queue_count() < BER_STORE_SPILL_LEVEL) {
+    return 0;
+  }
+  return ber_store_put(r, clock_seconds());
+#else
+  return 0;
+#endif
 }
 /*-------------------------------------------------*/
 static void
-parse_energest_data(const uint8_t *data, uint32_t *uint32_array, uint16_t datalen)
+output_flush(void)
 {
-  if(datalen != ENERGEST_PAYLOAD_BUFFER_SIZE * BYTES_PER_UINT32) {
-    printf("Data length mismatch\n");
-    return;
-  }
-  for(int i = 0; i < ENERGEST_PAYLOAD_BUFFER_SIZE; i++) {
-    bytes_to_uint32(data + i * BYTES_PER_UINT32, &uint32_array[i]);
-  }
+  batch_flush_requested = 1;
+  process_poll(&ber_output_process);
 }
 /*-------------------------------------------------*/
-void
-convertBytesToPayload(const uint8_t *bytes_payload, int *payload, int payload_size)
+PROCESS_THREAD(ber_output_process, ev, data)
 {
-  int byte_index = 0;
-  for(int i = 0; i < payload_size; ++i) {
-    payload[i] = bytes_to_int(&bytes_payload[byte_index]);
-    byte_index += BYTES_PER_INT;
+  static uint32_t dropped_reported;
+  static uint8_t batched;
+  static uint8_t pending;
+  static uint8_t node_index;
+  static uint8_t node_count;
+#if BER_STORE
+  static struct ber_record stored;
+  static uint32_t stored_seq;
+  static uint32_t stored_at;
+#endif
+  const struct ber_queue_stats *stats;
+  const struct ber_summary *s;
+  struct ber_record *r;
+  struct ber_node *n;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    /* Ahead of any batch, so the anchor waits for as little as possible */
+    if(anchor_requested) {
+      anchor_requested = 0;
+      ber_record_anchor(clock_seconds());
+    }
+
+    /* Binary frames are cheap to parse and are never batched */
+    batched = BER_BATCH_INTERVAL > 0 &&
+      ber_get_output_mode() == BER_OUTPUT_JSON;
+    if(batched) {
+      if(!batch_flush_requested &&
+         ber_queue_count() < BER_BATCH_MAX_RECORDS) {
+        continue;
+      }
+      pending = ber_queue_count();
+      if(pending > 0) {
+        ber_record_batch_begin(pending);
+      }
+    } else {
+      pending = BER_QUEUE_SIZE;
+    }
+    batch_flush_requested = 0;
+
+    /* Without batching, keep going until the queue is empty */
+    while((r = ber_queue_peek()) != NULL && pending > 0) {
+      if(!store_record(r)) {
+        ber_record_output(r, batched);
+      }
+      ber_queue_pop();
+      if(batched) {
+        pending--;
+      }
+
+      /* Let the network stack run between two records */
+      process_poll(&ber_output_process);
+      PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+    }
+
+    if(batched) {
+      ber_record_batch_end();
+    }
+
+    if(summary_requested) {
+      summary_requested = 0;
+      node_count = 0;
+      for(node_index = 0; node_index < BER_SUMMARY_SLOTS; node_index++) {
+        if((s = ber_summary_get(node_index)) != NULL) {
+          ber_record_summary(s, node_count++ == 0);
+          ber_summary_clear(node_index);
+          process_poll(&ber_output_process);
+          PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+        }
+      }
+      ber_record_summary_end(node_count);
+    }
+
+    if(node_stats_requested) {
+      node_stats_requested = 0;
+      node_count = 0;
+      for(node_index = 0; node_index < BER_NODE_TABLE_SIZE; node_index++) {
+        if((n = ber_node_get(node_index)) != NULL) {
+          ber_record_node_stats(n, node_count++ == 0);
+          process_poll(&ber_output_process);
+          PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+        }
+      }
+      ber_record_node_stats_end(node_count);
+    }
+
+    if(energy_requested) {
+      energy_requested = 0;
+      node_count = 0;
+      for(node_index = 0; node_index < BER_NODE_TABLE_SIZE; node_index++) {
+        if((n = ber_node_get(node_index)) != NULL && n->has_energy) {
+          ber_record_node_energy(n, node_count++ == 0);
+          process_poll(&ber_output_process);
+          PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+        }
+      }
+      ber_record_node_energy_end(node_count);
+    }
+
+    if(prof_requested) {
+      prof_requested = 0;
+      for(node_index = 0; node_index < BER_PROF_STAGES; node_index++) {
+        ber_record_prof(node_index, node_index == 0);
+      }
+      ber_record_prof_end(BER_PROF_STAGES);
+    }
+
+#if BER_STORE
+    /* Catch up on stored records while nothing live is waiting */
+    while(ber_queue_count() == 0 && ber_host_up() &&
+          ber_store_peek(&stored, &stored_seq, &stored_at)) {
+      ber_record_stored(&stored, stored_seq, stored_at);
+      ber_record_output(&stored, 0);
+      ber_store_pop();
+      process_poll(&ber_output_process);
+      PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+    }
+#endif
+
+    /* Records that arrived while we were busy */
+    if(ber_queue_count() > 0) {
+      process_poll(&ber_output_process);
+    }
+
+    stats = ber_queue_get_stats();
+    if(stats->dropped + stats->oversize != dropped_reported) {
+      dropped_reported = stats->dropped + stats->oversize;
+      LOG_WARN("Output queue: %lu records dropped, %lu oversize\n",
+               (unsigned long)stats->dropped, (unsigned long)stats->oversize);
+    }
   }
+
+  PROCESS_END();
 }
 /*-------------------------------------------------*/
-PROCESS(udp_server_process, "UDP server");
-AUTOSTART_PROCESSES(&udp_server_process);
-/*-------------------------------------------------*/
-static void
-udp_rx_callback(struct simple_udp_connection *c,
-                const uip_ipaddr_t *sender_addr,
-                uint16_t sender_port,
-                const uip_ipaddr_t *receiver_addr,
-                uint16_t receiver_port,
-                const uint8_t *data,
-                uint16_t datalen)
+#if BER_ACK_AGGREGATED
+PROCESS_THREAD(ber_ack_process, ev, data)
 {
-  ip_beautify(sender_addr);
-
-  LOG_INFO("############################################\n");
-  LOG_INFO("Received %u bytes, From %s \n", datalen, ipv6_decoded);
-  LOG_INFO("############################################\n");
-
-  int payload_size = (datalen > 0) ? (datalen / BYTES_PER_INT) : 1;
-
-  int payload[payload_size];
-
-  char buff[512];   /* Buffer for formatted string */
-
-  convertBytesToPayload(data, payload, payload_size);
-
-  switch(datalen) {
-    case 2:
-        // Handle PING case
-        sprintf(buff, "\n\rPING received from: %.*s \n\r", strlen(ipv6_decoded), ipv6_decoded);
-        printf("%s\n", buff);
-        break;
-
-    case 12:
-        // Handle Air Velocity and CO2 case
-        air_velocity = bytes_to_int(&data[4]);          // Convert bytes to int
-        air_velocity_int = air_velocity / 100;          // Integer part of air_velocity
-        air_velocity_frac = air_velocity % 100;         // Fractional part of air_velocity
-
-        // Prepare the JSON string
-        sprintf(buff,
-                "\nJSON_START\n{\n"
-                "    \"ipv6\":\"%.*s\",\n"
-                "    \"co2_ppm\":%d,\n"
-                "    \"air_velocity\":%d.%02d,\n"
-                "    \"package_number\":%d\n"
-                "}\nJSON_END\n",
-                (int)strlen(ipv6_decoded), ipv6_decoded,
-                bytes_to_int(&data[0]),
-                air_velocity_int, air_velocity_frac,
-                bytes_to_int(&data[8])
-        );
-
-        printf("%s\n", buff);
-        break;
-
-    case 68:
-        memset(buff, 0, sizeof(buff));
-        sprintf(buff,
-                "\nJSON_START\n{\n"
-                "    \"ipv6\":\"%.*s\",\n"
-                "    \"light\":%d.%02d,\n"
-                "    \"battery_t\":%d,\n"
-                "    \"battery\":%d,\n"
-                "    \"bmp_press\":%d.%02d,\n"
-                "    \"bmp_temp\":%d.%02d,\n"
-                "    \"hdc_temp\":%d.%02d,\n"
-                "    \"hdc_humidity\":%d.%02d,\n"
-                "    \"package_number\":%d\n"
-                "}\nJSON_END\n",
-                strlen(ipv6_decoded), ipv6_decoded,
-                bytes_to_int(&data[0]), bytes_to_int(&data[4]),    // light
-                bytes_to_int(&data[8]),                            // battery_t
-                bytes_to_int(&data[12]),                           // battery
-                bytes_to_int(&data[16]), bytes_to_int(&data[20]),  // bmp_press
-                bytes_to_int(&data[24]), bytes_to_int(&data[28]),  // bmp_temp
-                bytes_to_int(&data[32]), bytes_to_int(&data[36]),  // hdc_temp
-                bytes_to_int(&data[40]), bytes_to_int(&data[44]),  // hdc_humidity
-                bytes_to_int(&data[48])                            // package_number
-        );
-        printf("%s\n", buff);
-        break;
-
-
-    case 76:
-        // Handle the payload of size 76 (Placeholder)
-        print_payload_as_json(payload, payload_size, ipv6_decoded);
-        break;
-
-    default:
-        // Handle unexpected data lengths
-        LOG_INFO("Unexpected data length received.\n");
-        break;
-}
+  static struct etimer spacing_timer;
+  static uint8_t buf[BER_ACK_MAX_SIZE];
+  static uip_ipaddr_t dest;
+  static uint8_t node_index;
+  uint16_t len;
+#if BER_ACK_MODE == BER_ACK_UNICAST
+  struct ber_node *n;
+#endif
 
-#if WITH_SERVER_REPLY
-  /* Send ACK response for successfully processed payload */
-  LOG_INFO("Sending response.\n");
-  uint8_t ack_msg[4] = { 1, 0, 0, 1 };
-  simple_udp_sendto(&udp_conn, ack_msg, sizeof(ack_msg), sender_addr);
-#endif /* WITH_SERVER_REPLY */
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    /* One round: every node heard from since the last one gets its window */
+    node_index = 0;
+    while(node_index < BER_NODE_TABLE_SIZE) {
+#if BER_ACK_MODE == BER_ACK_BROADCAST
+      len = ber_ack_build(buf, sizeof(buf), &node_index);
+      uip_create_linklocal_allnodes_mcast(&dest);
+#else
+      n = ber_node_get(node_index++);
+      if(n == NULL || !n->ack_pending) {
+        continue;
+      }
+      len = ber_ack_build_node(buf, sizeof(buf), n);
+      memcpy(dest.u8, n->addr, sizeof(dest.u8));
+#endif
+      if(len == 0) {
+        continue;
+      }
+#if BER_LEGACY_PORTS && BER_ACK_MODE == BER_ACK_BROADCAST
+      if(legacy_heard) {
+        simple_udp_sendto(&legacy_conn, buf, len, &dest);
+      }
+      simple_udp_sendto(&udp_conn, buf, len, &dest);
+#elif BER_LEGACY_PORTS
+      simple_udp_sendto(n->legacy_port ? &legacy_conn : &udp_conn,
+                        buf, len, &dest);
+#else
+      simple_udp_sendto(&udp_conn, buf, len, &dest);
+#endif
+
+      /* Do not flood the TSCH queue with a whole round at once */
+      etimer_set(&spacing_timer, BER_ACK_SPACING);
+      PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&spacing_timer));
+    }
+  }
+
+  PROCESS_END();
 }
+#endif /* BER_ACK_AGGREGATED */
+/*-------------------------------------------------*/
 PROCESS_THREAD(udp_server_process, ev, data) {
+#if BER_BATCH_INTERVAL > 0
+  static struct etimer batch_timer;
+#endif
+#if BER_NODE_STATS_INTERVAL > 0
+  static struct etimer node_stats_timer;
+#endif
+#if BER_ENERGY_INTERVAL > 0
+  static struct etimer energy_timer;
+#endif
+#if BER_PROF_INTERVAL > 0
+  static struct etimer prof_timer;
+#endif
+#if BER_ANCHOR_INTERVAL > 0
+  static struct etimer anchor_timer;
+#endif
+#if BER_SUMMARY_INTERVAL > 0
+  static struct etimer summary_timer;
+#endif
+#if BER_ACK_AGGREGATED
+  static struct etimer ack_timer;
+#endif
+#if BER_ORCHESTRA_ADAPT_INTERVAL > 0
+  static struct etimer adapt_timer;
+  static uint32_t adapt_dropped;
+  const struct ber_queue_stats *queue_stats;
+#endif
 
   PROCESS_BEGIN();
   NETSTACK_ROUTING.root_start();
   NETSTACK_MAC.on();
+#if MAC_CONF_WITH_TSCH
   tsch_set_coordinator(1);
+#endif
+#if BUILD_WITH_ORCHESTRA
+  ber_orchestra_root_start();
+  ber_ack_set_cells(ber_orchestra_get_cells());
+#endif
 
   /* Initialize UDP connection */
-  simple_udp_register(&udp_conn, UDP_SERVER_PORT, NULL,
-                      UDP_CLIENT_PORT, udp_rx_callback);
+  simple_udp_register(&udp_conn, BER_UDP_SERVER_PORT, NULL,
+                      BER_UDP_CLIENT_PORT, udp_rx_callback);
+#if BER_LEGACY_PORTS
+  simple_udp_register(&legacy_conn, BER_UDP_LEGACY_SERVER_PORT, NULL,
+                      BER_UDP_LEGACY_CLIENT_PORT, udp_rx_callback);
+#endif
+  process_start(&ber_output_process, NULL);
+  ber_anchor();
+#if BER_STORE
+  if(ber_store_init(ber_store_platform_flash()) != 0) {
+    LOG_WARN("No flash for the record store, records will not be kept\n");
+  } else if(ber_store_get_stats()->pending > 0) {
+    LOG_INFO("%lu stored records to replay\n",
+             (unsigned long)ber_store_get_stats()->pending);
+    process_poll(&ber_output_process);
+  }
+#endif
+#if BER_ACK_AGGREGATED
+  process_start(&ber_ack_process, NULL);
+#endif
+  ber_shell_init();
 
   LOG_INFO("\n\n\r%s\n", ASCII_ART);
 
@@ -466,6 +599,91 @@ PROCESS_THREAD(udp_server_process, ev, data) {
   LOG_INFO("> Version Number: 2.0.2.\n");
   LOG_INFO("> Initialization Completed Successfully.\n");
 
+#if BER_BATCH_INTERVAL > 0
+  etimer_set(&batch_timer, BER_BATCH_INTERVAL);
+#endif
+#if BER_NODE_STATS_INTERVAL > 0
+  etimer_set(&node_stats_timer, BER_NODE_STATS_INTERVAL);
+#endif
+#if BER_ENERGY_INTERVAL > 0
+  etimer_set(&energy_timer, BER_ENERGY_INTERVAL);
+#endif
+#if BER_PROF_INTERVAL > 0
+  etimer_set(&prof_timer, BER_PROF_INTERVAL);
+#endif
+#if BER_ANCHOR_INTERVAL > 0
+  etimer_set(&anchor_timer, BER_ANCHOR_INTERVAL);
+#endif
+#if BER_SUMMARY_INTERVAL > 0
+  etimer_set(&summary_timer, BER_SUMMARY_INTERVAL);
+#endif
+#if BER_ACK_AGGREGATED
+  etimer_set(&ack_timer, BER_ACK_INTERVAL);
+#endif
+#if BER_ORCHESTRA_ADAPT_INTERVAL > 0
+  etimer_set(&adapt_timer, BER_ORCHESTRA_ADAPT_INTERVAL);
+#endif
+
+  while(1) {
+    PROCESS_WAIT_EVENT();
+
+#if BER_BATCH_INTERVAL > 0
+    if(ev == PROCESS_EVENT_TIMER && data == &batch_timer) {
+      output_flush();
+      etimer_reset(&batch_timer);
+    }
+#endif
+#if BER_NODE_STATS_INTERVAL > 0
+    if(ev == PROCESS_EVENT_TIMER && data == &node_stats_timer) {
+      node_stats_requested = 1;
+      process_poll(&ber_output_process);
+      etimer_reset(&node_stats_timer);
+    }
+#endif
+#if BER_ENERGY_INTERVAL > 0
+    if(ev == PROCESS_EVENT_TIMER && data == &energy_timer) {
+      energy_requested = 1;
+      process_poll(&ber_output_process);
+      etimer_reset(&energy_timer);
+    }
+#endif
+#if BER_PROF_INTERVAL > 0
+    if(ev == PROCESS_EVENT_TIMER && data == &prof_timer) {
+      prof_requested = 1;
+      process_poll(&ber_output_process);
+      etimer_reset(&prof_timer);
+    }
+#endif
+#if BER_ANCHOR_INTERVAL > 0
+    if(ev == PROCESS_EVENT_TIMER && data == &anchor_timer) {
+      ber_anchor();
+      etimer_reset(&anchor_timer);
+    }
+#endif
+#if BER_SUMMARY_INTERVAL > 0
+    if(ev == PROCESS_EVENT_TIMER && data == &summary_timer) {
+      ber_summary_close();
+      etimer_reset(&summary_timer);
+    }
+#endif
+#if BER_ACK_AGGREGATED
+    if(ev == PROCESS_EVENT_TIMER && data == &ack_timer) {
+      process_poll(&ber_ack_process);
+      etimer_reset(&ack_timer);
+    }
+#endif
+#if BER_ORCHESTRA_ADAPT_INTERVAL > 0
+    if(ev == PROCESS_EVENT_TIMER && data == &adapt_timer) {
+      queue_stats = ber_queue_get_stats();
+      ber_orchestra_adapt(ber_record_get_stats()->received,
+                          queue_stats->dropped != adapt_dropped);
+      adapt_dropped = queue_stats->dropped;
+      ber_ack_set_cells(ber_orchestra_get_cells());
+      etimer_reset(&adapt_timer);
+    }
+#endif
+  }
+
   PROCESS_END();
 }
 /*
@@ -42,7 +42,8 @@
  #ifndef BER_H_
  #define BER_H_
 
- #include "contiki.h"
+ #include <stdbool.h>
+ #include <stdint.h>
 
  /**
   * \brief Initialize the Base Edge Router.
@@ -54,6 +55,62 @@
   */
  void ber_process(void);
 
+ /* Output modes for records written to the UART */
+ #define BER_OUTPUT_JSON   0 /* Pretty-printed JSON between JSON_START/JSON_END */
+ #define BER_OUTPUT_BINARY 1 /* COBS frames, see ber-frame.h and tools/ber-decode */
+ #define BER_OUTPUT_NDJSON 2 /* One JSON object per line, no markers or banners */
+ #define BER_OUTPUT_CSV    3 /* One row per record, a header row once per kind */
+
+ /* UDP ports of the sensor network. Ports 0xF0B0-0xF0BF compress to 4 bits
+    each in the 6LoWPAN UDP header (RFC 6282), so the pair takes one byte on
+    air instead of four. */
+ #define BER_UDP_SERVER_PORT 0xF0B0 /* The BER */
+ #define BER_UDP_CLIENT_PORT 0xF0B1 /* The nodes */
+
+ /* Ports of node firmware from before the compressible pair */
+ #define BER_UDP_LEGACY_SERVER_PORT 1234
+ #define BER_UDP_LEGACY_CLIENT_PORT 4321
+
+ /**
+  * \brief Select how received records are written to the UART.
+  * \param mode One of BER_OUTPUT_*
+  */
+ void ber_set_output_mode(uint8_t mode);
+
+ /**
+  * \brief Get the current output mode.
+  */
+ uint8_t ber_get_output_mode(void);
+
+ /**
+  * \brief Note that the host reading the UART is alive.
+  *
+  * Called for each "ber alive" the host sends. Records are kept in flash
+  * while it is down, see BER_CONF_STORE_HOST_TIMEOUT.
+  */
+ void ber_host_alive(void);
+
+ /**
+  * \brief Whether the host reading the UART is taken as up.
+  */
+ int ber_host_up(void);
+
+ /**
+  * \brief Write a time anchor as soon as the output is free.
+  *
+  * Anchors also go out every BER_CONF_ANCHOR_INTERVAL; without
+  * BER_CONF_TIME this does nothing. See ber-time.h.
+  */
+ void ber_anchor(void);
+
+ /**
+  * \brief Close the summary window now and write its summaries.
+  *
+  * Windows also close every BER_CONF_SUMMARY_INTERVAL; without
+  * BER_CONF_SUMMARY this does nothing. See ber-summary.h.
+  */
+ void ber_summary_close(void);
+
  #endif /* BER_H_ */
 
  /** @} */
@@ -61,11 +118,60 @@
 #ifndef BER_H
 #define BER_H
 
-#define IMF4D_BASE_SENSORS_COUNT 19
+/*
+ * Sensor fields of the IMF4D boards, one X(key, raw_key, precision) entry
+ * per little-endian int32 in the payload, in wire order. precision is the
+ * number of decimal digits the node scaled the reading by (0 for plain
+ * integers). The payload schemas in ber-schema.c, and so every key the
+ * BER writes, are generated from these lists.
+ */
+#define IMF4D_BASE_SENSORS(X) \
+  X(bmp_390_u18_pressure,        bmp_390_u18_pressure_raw,        4) \
+  X(bmp_390_u18_temperature,     bmp_390_u18_temperature_raw,     2) \
+  X(bmp_390_u19_pressure,        bmp_390_u19_pressure_raw,        4) \
+  X(bmp_390_u19_temperature,     bmp_390_u19_temperature_raw,     2) \
+  X(hdc_2010_u13_temperature,    hdc_2010_u13_temperature_raw,    2) \
+  X(hdc_2010_u13_humidity,       hdc_2010_u13_humidity_raw,       2) \
+  X(hdc_2010_u16_temperature,    hdc_2010_u16_temperature_raw,    2) \
+  X(hdc_2010_u16_humidity,       hdc_2010_u16_humidity_raw,       2) \
+  X(hdc_2010_u17_temperature,    hdc_2010_u17_temperature_raw,    2) \
+  X(hdc_2010_u17_humidity,       hdc_2010_u17_humidity_raw,       2) \
+  X(opt_3001_u1_light_intensity, opt_3001_u1_light_intensity_raw, 2) \
+  X(opt_3001_u2_light_intensity, opt_3001_u2_light_intensity_raw, 2) \
+  X(opt_3001_u3_light_intensity, opt_3001_u3_light_intensity_raw, 2) \
+  X(opt_3001_u4_light_intensity, opt_3001_u4_light_intensity_raw, 2) \
+  X(opt_3001_u5_light_intensity, opt_3001_u5_light_intensity_raw, 2) \
+  X(batmon_temperature,          batmon_temperature_raw,          0) \
+  X(batmon_battery_voltage,      batmon_battery_voltage_raw,      0) \
+  X(package_number,              package_number,                  0) \
+  X(rssi,                        rssi,                            0)
+
+/* Advanced board, followed on the wire by a package_number field */
+#define IMF4D_ADVANCED_SENSORS(X) \
+  X(co2_ppm,                     co2_ppm_raw,                     0) \
+  X(air_velocity,                air_velocity_raw,                2)
+
+/*
+ * Legacy SensorTag board, X(key, byte offset, precision). Fields with a
+ * precision are sent as an integer part followed by a fractional part.
+ */
+#define LEGACY_SENSORS(X) \
+  X(light,                        0, 2) \
+  X(battery_t,                    8, 0) \
+  X(battery,                     12, 0) \
+  X(bmp_press,                   16, 2) \
+  X(bmp_temp,                    24, 2) \
+  X(hdc_temp,                    32, 2) \
+  X(hdc_humidity,                40, 2) \
+  X(package_number,              48, 0)
 
-#define IMF4D_ADVANCED_SENSORS_COUNT 2
+#define IMF4D_SENSOR_COUNT(key, raw_key, precision)   + 1
 
-#define OLD_SP_KEYS_SIZE 11
+#define IMF4D_BASE_SENSORS_COUNT \
+  (0 IMF4D_BASE_SENSORS(IMF4D_SENSOR_COUNT))
+
+#define IMF4D_ADVANCED_SENSORS_COUNT \
+  (0 IMF4D_ADVANCED_SENSORS(IMF4D_SENSOR_COUNT))
 
 #define ASCII_ART \
 " ███████████ █████ █████  ██████████  \n"\
@@ -77,120 +183,4 @@
 " █████             █████  ██████████  \n"\
 "░░░░░             ░░░░░  ░░░░░░░░░░   \n"
 
-
-
-
-
-const char* quotes[] = {
-    "If debugging is the process of removing software bugs, then programming must be the process of putting them in.",
-    "In order to understand recursion, one must first understand recursion.",
-    "There are only two hard things in computer science: cache invalidation and naming things.",
-    "Programming today is a race between software engineers striving to build bigger and better idiot-proof programs, and the Universe trying to produce bigger and better idiots. So far, the Universe is winning.",
-    "Code never lies, comments sometimes do.",
-    "Quality is not an act, it is a habit.",
-    "The strength of JavaScript is that you can do anything. The weakness is that you will.",
-    "A good programmer looks both ways before crossing a one-way street.",
-    "It’s harder to read code than to write it.",
-    "The most important property of a program is whether it accomplishes the intention of its user.",
-    "Programs must be written for people to read, and only incidentally for machines to execute.",
-    "Programming is the art of doing one thing at a time.",
-    "The best code is no code at all.",
-    "Java is to JavaScript what Car is to Carpet.",
-    "Real programmers can write assembly code in any language.",
-    "It’s not about how fast you can code, but how well you can think."
-};
-
-static const char *old_sensor_keys[OLD_SP_KEYS_SIZE] = {
-    "light",
-    "battery_t",
-    "battery",
-    "bmp_press",
-    "bmp_temp",
-    "hdc_temp",
-    "hdc_humidity",
-    "tmp107_amb",
-    "tmp107_obj",
-    "packet_number",
-    "rssi"
-};
-
-// Array for raw sensor keys
-static const char *raw_sensor_keys[IMF4D_BASE_SENSORS_COUNT] = {
-    "bmp_390_u18_pressure_raw",
-    "bmp_390_u18_temperature_raw",
-    "bmp_390_u19_pressure_raw",
-    "bmp_390_u19_temperature_raw",
-    "hdc_2010_u13_temperature_raw",
-    "hdc_2010_u13_humidity_raw",
-    "hdc_2010_u16_temperature_raw",
-    "hdc_2010_u16_humidity_raw",
-    "hdc_2010_u17_temperature_raw",
-    "hdc_2010_u17_humidity_raw",
-    "opt_3001_u1_light_intensity_raw",
-    "opt_3001_u2_light_intensity_raw",
-    "opt_3001_u3_light_intensity_raw",
-    "opt_3001_u4_light_intensity_raw",
-    "opt_3001_u5_light_intensity_raw",
-    "batmon_temperature_raw",
-    "batmon_battery_voltage_raw",
-    "package_number",
-    "rssi"
-
-};
-
-
-static const char *raw_adv_sensor_keys[IMF4D_ADVANCED_SENSORS_COUNT] = {
-    "co2_ppm_raw",
-     "air_velocity_raw"
-
-
-};
-
-// Array for decimal sensor keys
-static const char *decimal_sensor_keys[IMF4D_BASE_SENSORS_COUNT] = {
-    "bmp_390_u18_pressure",
-    "bmp_390_u18_temperature",
-    "bmp_390_u19_pressure",
-    "bmp_390_u19_temperature",
-    "hdc_2010_u13_temperature",
-    "hdc_2010_u13_humidity",
-    "hdc_2010_u16_temperature",
-    "hdc_2010_u16_humidity",
-    "hdc_2010_u17_temperature",
-    "hdc_2010_u17_humidity",
-    "opt_3001_u1_light_intensity",
-    "opt_3001_u2_light_intensity",
-    "opt_3001_u3_light_intensity",
-    "opt_3001_u4_light_intensity",
-    "opt_3001_u5_light_intensity",
-    "batmon_temperature",
-    "batmon_battery_voltage",
-    "package_number",
-    "rssi"
-};
-
-
-static const char *decimal_adv_sensor_keys[IMF4D_ADVANCED_SENSORS_COUNT] = {
- "co2_ppm",
-    "air_velocity"
-
-};
-
-    // Flags for sensors that should be displayed as floating-point
-static const bool *is_float[OLD_SP_KEYS_SIZE] = {
-        true,  // "light"
-        false, // "battery_t"
-        false, // "battery"
-        true,  // "bmp_press"
-        true,  // "bmp_temp"
-        true,  // "hdc_temp"
-        true,  // "hdc_humidity"
-        true,  // "tmp107_amb"
-        true,  // "tmp107_obj"
-        false, // "packet_number"
-        false  // "rssi"
-    };
-
-
-
 #endif // BER_H
\ No newline at end of file
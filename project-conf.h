@@ -35,6 +35,75 @@
 
 #define BER_DEBUG 1
 
+/* UART record format: BER_OUTPUT_JSON, _NDJSON, _CSV or _BINARY (see ber.h) */
+#define BER_CONF_OUTPUT_MODE BER_OUTPUT_JSON
+#define BER_CONF_FRAME_NODE_ID 0
+#define BER_CONF_VERBOSE       1
+
+/* Records waiting for the UART; overwrite the oldest instead of dropping new ones */
+#define BER_QUEUE_CONF_SIZE        8
+#define BER_QUEUE_CONF_DROP_OLDEST 0
+
+/* Write JSON records as one array per interval (0 = one block per record) */
+#define BER_CONF_BATCH_INTERVAL    0 /* e.g. (5 * CLOCK_SECOND) */
+#define BER_CONF_BATCH_MAX_RECORDS 6
+
+/* Per-node duplicate suppression and sequence counters (see ber-node.h) */
+#define BER_CONF_DROP_DUPLICATES     1
+#define BER_CONF_NODE_STATS_INTERVAL (300 * CLOCK_SECOND)
+#define BER_CONF_ENERGY_INTERVAL     (600 * CLOCK_SECOND)
+
+#define BER_CONF_PROF          0 /* Stage timing histograms, see ber-prof.h */
+#define BER_CONF_PROF_INTERVAL (60 * CLOCK_SECOND)
+
+/* Node acknowledgments: BER_ACK_NONE, _PER_PACKET, _UNICAST or _BROADCAST */
+#define BER_CONF_ACK_MODE     BER_ACK_NONE
+#define BER_CONF_ACK_INTERVAL (30 * CLOCK_SECOND)
+
+/* Keep records in flash while the host is away (see ber-store.h). Set the
+   timeout once the host sends "ber alive" more often than that; until then
+   only records the UART cannot keep up with are stored. */
+#define BER_CONF_STORE              1
+#define BER_CONF_STORE_HOST_TIMEOUT 0 /* e.g. (30 * CLOCK_SECOND) */
+
+/* Per-node token buckets, see ber-rate.h; the rates are per message class */
+#define BER_CONF_RATE 1
+
+/* Stamp records with the TSCH ASN they were received at, and write a time
+   anchor every BER_CONF_ANCHOR_INTERVAL (see ber-time.h) */
+#define BER_CONF_TIME            1
+#define BER_CONF_ANCHOR_INTERVAL (60 * CLOCK_SECOND)
+
+/* Low-resolution mode: one min/max/mean/sd summary per node and window
+   instead of every record (see ber-summary.h). Each slot is ~600 bytes of
+   RAM; nodes beyond BER_SUMMARY_CONF_SLOTS are forwarded raw. */
+#define BER_CONF_SUMMARY          0
+#define BER_CONF_SUMMARY_INTERVAL (15 * 60 * CLOCK_SECOND)
+#define BER_SUMMARY_CONF_SLOTS    8
+
+/* Keep listening on the old 1234/4321 ports next to the compressible pair */
+#define BER_CONF_LEGACY_PORTS 1
+
+/* "make BER_ROUTING=non-storing" or "=lite" (see Makefile.routing): only the
+   root keeps routes, one ~25-byte source-route link per node, so the route
+   table can cover the field. The BER node table follows it, except on the
+   CC2650: at 256 bytes an entry, 128 of them would not fit its 20 KB, so
+   it stays at 16 and evicts the least recently heard node past that. */
+#if BER_CONF_RPL_NON_STORING
+#define RPL_CONF_MOP RPL_MOP_NON_STORING
+#ifndef NETSTACK_CONF_MAX_ROUTE_ENTRIES
+#define NETSTACK_CONF_MAX_ROUTE_ENTRIES 128
+#endif
+#if CONTIKI_TARGET_SIMPLELINK && !defined(BER_NODE_CONF_TABLE_SIZE)
+#define BER_NODE_CONF_TABLE_SIZE 16
+#endif
+#endif
+
+/* RAM budget: BER_NODE_CONF_ADDR_CACHE 0 saves the 40 bytes of address text
+   per node, at the cost of formatting the address for every record. Route
+   and neighbor tables keep their Contiki-NG sizes; read the map of a real
+   build with tools/ber-ram.py before spending RAM on them. */
+
 /* Logging */
 #define LOG_CONF_LEVEL_RPL                         LOG_LEVEL_NONE
 #define LOG_CONF_LEVEL_TCPIP                       LOG_LEVEL_NONE
@@ -45,16 +114,33 @@
 #define SICSLOWPAN_CONF_FRAG 0 /* No fragmentation */
 #define UIP_CONF_BUFFER_SIZE 500
 
+/* Reports go to BER_UDP_SERVER_PORT (ber.h), whose port pair compresses.
+   Addresses compress through 6LoWPAN context 0, which Contiki-NG sets to
+   the default fd00::/64 prefix the root announces; a deployment with
+   another prefix must set SICSLOWPAN_CONF_ADDR_CONTEXT_0 on every node. */
+
 
 #define RF_BLE_CONF_ENABLED 0
 #define RF_CONF_MODE        RF_MODE_2_4_GHZ
 #define CCXXWARE_CONF_ROM_BOOTLOADER_ENABLE 1
 // #define IEEE802154_CONF_PANID 0x0059
 #define IEEE802154_CONF_PANID 0xF4D0
+/* Extra uplink cells at the root, ahead of the unicast rule (ber-orchestra.h) */
+extern struct orchestra_rule ber_root_uplink;
+#if BER_CONF_RPL_NON_STORING
 #define ORCHESTRA_CONF_RULES                                                \
   {                                                                         \
-    &eb_per_time_source, &unicast_per_neighbor_rpl_storing, &default_common \
+    &eb_per_time_source, &ber_root_uplink,                                  \
+    &unicast_per_neighbor_rpl_ns, &default_common                           \
   }
+#else
+#define ORCHESTRA_CONF_RULES                                                \
+  {                                                                         \
+    &eb_per_time_source, &ber_root_uplink,                                  \
+    &unicast_per_neighbor_rpl_storing, &default_common                      \
+  }
+#endif
+#define BER_CONF_ORCHESTRA_ADAPT_INTERVAL (60 * CLOCK_SECOND)
 
 // #define TSCH_CONF_AUTOSTART 0
 
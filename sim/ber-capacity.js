@@ -0,0 +1,147 @@
+/*
+ * BER capacity scenario: the BER (mote 1) is the root, every other mote runs
+ * sensor-sim and reports once a minute. After a warm-up, the script follows
+ * every reading sent during the measurement window, lets the network drain,
+ * and then reports packet delivery ratio, end-to-end latency (node "tx" line
+ * to the BER printing the record), root queue drops and UART bytes/sec.
+ *
+ * The scenario passes when the PDR and the 95th percentile latency stay
+ * within the limits for its size below. Generated scenarios share this file;
+ * see gen-scenarios.py.
+ */
+
+/* Simulation time is in microseconds */
+var SECOND = 1000000;
+var WARMUP = 15 * 60 * SECOND;   /* RPL and TSCH formation */
+var MEASURE = 30 * 60 * SECOND;  /* Readings sent in here are counted */
+var DRAIN = 3 * 60 * SECOND;     /* Time left for the last ones to arrive */
+
+/* Serial line rate of the BER UART, for the utilization figure */
+var UART_BYTES_PER_SEC = 115200 / 10;
+
+/* Pass limits by number of sensor nodes: [max nodes, min PDR, max p95 s] */
+var LIMITS = [
+  [10, 0.99, 5],
+  [50, 0.98, 10],
+  [150, 0.95, 20],
+  [300, 0.90, 30]
+];
+
+var sensors = sim.getMotesCount() - 1;
+var limit = LIMITS[LIMITS.length - 1];
+for(var i = 0; i < LIMITS.length; i++) {
+  if(sensors <= LIMITS[i][0]) {
+    limit = LIMITS[i];
+    break;
+  }
+}
+
+TIMEOUT((WARMUP + MEASURE + DRAIN) / 1000 + 120000,
+        log.log("RESULT timeout, no statistics from the BER\n"));
+
+var ber = sim.getMoteWithID(1);
+var sent = {};        /* package_number -> tx time */
+var expected = 0;     /* Readings due in the window, sent or not */
+var unreachable = 0;  /* Readings skipped because the node had not joined */
+var delivered = 0;
+var latencies = [];
+var stats = [];       /* BER counters at the start and the end of the window */
+var pending = null;
+
+function stats_query() {
+  pending = { time: time, dropped: -1, bytes: -1 };
+  write(ber, "ber");
+}
+
+function in_window(t) {
+  return t >= WARMUP && t < WARMUP + MEASURE;
+}
+
+GENERATE_MSG(WARMUP / 1000, "sim:start");
+GENERATE_MSG((WARMUP + MEASURE + DRAIN) / 1000, "sim:end");
+
+log.log("Capacity scenario: " + sensors + " sensor nodes, limits PDR >= " +
+        limit[1] + ", p95 latency <= " + limit[2] + " s\n");
+
+while(true) {
+  YIELD();
+  var line = String(msg);
+  var m;
+
+  if(line == "sim:start" || line == "sim:end") {
+    stats_query();
+    continue;
+  }
+
+  if(id == 1) {
+    m = line.match(/"package_number":(\d+)/);
+    if(m && sent[m[1]] !== undefined) {
+      latencies.push(time - sent[m[1]]);
+      delete sent[m[1]];
+      delivered++;
+      continue;
+    }
+    if(pending != null) {
+      m = line.match(/Output: \w+, verbose \w+, (\d+) bytes written/);
+      if(m) {
+        pending.bytes = parseInt(m[1]);
+      }
+      m = line.match(/Queue: .*, (\d+) dropped/);
+      if(m) {
+        pending.dropped = parseInt(m[1]);
+      }
+      if(pending.bytes >= 0 && pending.dropped >= 0) {
+        stats.push(pending);
+        pending = null;
+        if(stats.length == 2) {
+          break;
+        }
+      }
+    }
+    continue;
+  }
+
+  m = line.match(/\] tx (\d+)/);
+  if(m && in_window(time)) {
+    sent[m[1]] = time;
+    expected++;
+    continue;
+  }
+  m = line.match(/\] unreachable \d+/);
+  if(m && in_window(time)) {
+    expected++;
+    unreachable++;
+  }
+}
+
+latencies.sort(function(a, b) { return a - b; });
+var sum = 0;
+for(var i = 0; i < latencies.length; i++) {
+  sum += latencies[i];
+}
+var pdr = expected > 0 ? delivered / expected : 0;
+var mean = latencies.length > 0 ? sum / latencies.length / SECOND : 0;
+var p95 = latencies.length > 0 ?
+  latencies[Math.floor((latencies.length - 1) * 0.95)] / SECOND : 0;
+var max = latencies.length > 0 ? latencies[latencies.length - 1] / SECOND : 0;
+var seconds = (stats[1].time - stats[0].time) / SECOND;
+var bytes_per_sec = (stats[1].bytes - stats[0].bytes) / seconds;
+
+log.log("RESULT nodes=" + sensors +
+        " expected=" + expected +
+        " delivered=" + delivered +
+        " unreachable=" + unreachable +
+        " pdr=" + pdr.toFixed(4) +
+        " latency_mean=" + mean.toFixed(3) +
+        " latency_p95=" + p95.toFixed(3) +
+        " latency_max=" + max.toFixed(3) +
+        " queue_drops=" + (stats[1].dropped - stats[0].dropped) +
+        " uart_bytes_per_sec=" + bytes_per_sec.toFixed(1) +
+        " uart_utilization=" + (bytes_per_sec / UART_BYTES_PER_SEC).toFixed(4) +
+        "\n");
+
+if(pdr >= limit[1] && p95 <= limit[2]) {
+  log.testOK();
+} else {
+  log.testFailed();
+}
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+#
+# Generate the Cooja capacity scenarios: the BER as root in the middle of a
+# grid of sensor-sim nodes, with ber-capacity.js as the test script.
+#
+# Usage: gen-scenarios.py [-o dir] [-s spacing] [-r routing] [-l] [nodes ...]
+#
+# The checked-in ber-<nodes>.csc files are the output of running this with no
+# arguments, and ber-<nodes>-non-storing.csc of running it with
+# -r non-storing; regenerate them rather than editing them by hand.
+#
+# -l builds the nodes with the UDP ports of firmware from before the
+# compressible pair, into ber-<nodes>[-<routing>]-legacy-ports.csc, for a
+# radio log to compare with tools/ber-airtime.py.
+
+import argparse
+import math
+import os
+
+DEFAULT_NODES = [10, 50, 150, 300]
+ROUTINGS = ["storing", "non-storing", "lite"]  # See ../Makefile.routing
+
+# UDGM ranges in meters; with the default 30 m grid a node reaches its eight
+# neighbors, so larger scenarios are several hops deep
+TX_RANGE = 50.0
+INTERFERENCE_RANGE = 100.0
+SEED = 123456
+
+# The BER indexes its node table with a uint8_t (see ber-node.h)
+BER_NODE_TABLE_MAX = 255
+
+MOTE_INTERFACES = [
+    "org.contikios.cooja.interfaces.Position",
+    "org.contikios.cooja.interfaces.Battery",
+    "org.contikios.cooja.contikimote.interfaces.ContikiVib",
+    "org.contikios.cooja.contikimote.interfaces.ContikiMoteID",
+    "org.contikios.cooja.contikimote.interfaces.ContikiRS232",
+    "org.contikios.cooja.contikimote.interfaces.ContikiBeeper",
+    "org.contikios.cooja.interfaces.IPAddress",
+    "org.contikios.cooja.contikimote.interfaces.ContikiRadio",
+    "org.contikios.cooja.contikimote.interfaces.ContikiButton",
+    "org.contikios.cooja.contikimote.interfaces.ContikiPIR",
+    "org.contikios.cooja.contikimote.interfaces.ContikiClock",
+    "org.contikios.cooja.contikimote.interfaces.ContikiLED",
+    "org.contikios.cooja.contikimote.interfaces.ContikiCFS",
+    "org.contikios.cooja.contikimote.interfaces.ContikiEEPROM",
+    "org.contikios.cooja.interfaces.Mote2MoteRelations",
+    "org.contikios.cooja.interfaces.MoteAttributes",
+]
+
+
+def grid_positions(count, spacing):
+    """Positions for the root and count nodes, root nearest the grid center."""
+    side = math.ceil(math.sqrt(count + 1))
+    center = (side - 1) / 2.0
+    cells = [(x, y) for y in range(side) for x in range(side)]
+    # Root first, then the nodes nearest to it
+    cells.sort(key=lambda c: ((c[0] - center) ** 2 + (c[1] - center) ** 2,
+                              c[1], c[0]))
+    return [((x - center) * spacing, (y - center) * spacing)
+            for x, y in cells[:count + 1]]
+
+
+def mote(mote_id, pos):
+    return """      <mote>
+        <interface_config>
+          org.contikios.cooja.interfaces.Position
+          <pos x="{x:.1f}" y="{y:.1f}" />
+        </interface_config>
+        <interface_config>
+          org.contikios.cooja.contikimote.interfaces.ContikiMoteID
+          <id>{id}</id>
+        </interface_config>
+      </mote>
+""".format(x=pos[0], y=pos[1], id=mote_id)
+
+
+def mote_type(description, source, commands, motes):
+    interfaces = "".join("      <moteinterface>{}</moteinterface>\n".format(i)
+                         for i in MOTE_INTERFACES)
+    return """    <motetype>
+      org.contikios.cooja.contikimote.ContikiMoteType
+      <description>{description}</description>
+      <source>{source}</source>
+      <commands>{commands}</commands>
+{interfaces}{motes}    </motetype>
+""".format(description=description, source=source,
+           commands="\n".join(commands), interfaces=interfaces,
+           motes="".join(motes))
+
+
+def scenario_name(count, routing, legacy_ports=False):
+    name = "ber-{}".format(count)
+    if routing != "storing":
+        name += "-" + routing
+    if legacy_ports:
+        name += "-legacy-ports"
+    return name + ".csc"
+
+
+def scenario(count, spacing, routing, legacy_ports=False):
+    pos = grid_positions(count, spacing)
+    routes = count + 8
+    ber_defines = ",".join([
+        "NETSTACK_CONF_MAX_ROUTE_ENTRIES={}".format(routes),
+        "NBR_TABLE_CONF_MAX_NEIGHBORS=32",
+        "BER_NODE_CONF_TABLE_SIZE={}".format(min(count, BER_NODE_TABLE_MAX)),
+    ])
+    sensor_defines = "NETSTACK_CONF_MAX_ROUTE_ENTRIES={}".format(routes)
+    if legacy_ports:
+        sensor_defines += ",SIM_CONF_LEGACY_PORTS=1"
+    make_vars = "TARGET=cooja BER_ROUTING=" + routing
+
+    # Scenarios differ only in their build variables, so always rebuild
+    ber = mote_type(
+        "BER", "[CONFIG_DIR]/../ber.c",
+        ["$(MAKE) TARGET=cooja clean",
+         "$(MAKE) -j$(CPUS) ber.cooja {} DEFINES={}".format(make_vars,
+                                                          ber_defines)],
+        [mote(1, pos[0])])
+    sensors = mote_type(
+        "Sensor node", "[CONFIG_DIR]/sensor-sim/sensor-sim.c",
+        ["$(MAKE) TARGET=cooja clean",
+         "$(MAKE) -j$(CPUS) sensor-sim.cooja {} DEFINES={}".format(
+             make_vars, sensor_defines)],
+        [mote(i + 1, pos[i]) for i in range(1, count + 1)])
+
+    return """<?xml version="1.0" encoding="UTF-8"?>
+<!-- Generated by gen-scenarios.py, do not edit -->
+<simconf version="2023090101">
+  <simulation>
+    <title>BER capacity, {count} nodes, {routing}{ports}</title>
+    <randomseed>{seed}</randomseed>
+    <motedelay_us>1000000</motedelay_us>
+    <radiomedium>
+      org.contikios.cooja.radiomediums.UDGM
+      <transmitting_range>{tx}</transmitting_range>
+      <interference_range>{interference}</interference_range>
+      <success_ratio_tx>1.0</success_ratio_tx>
+      <success_ratio_rx>1.0</success_ratio_rx>
+    </radiomedium>
+    <events>
+      <logoutput>40000</logoutput>
+    </events>
+{ber}{sensors}  </simulation>
+  <plugin>
+    org.contikios.cooja.plugins.ScriptRunner
+    <plugin_config>
+      <scriptfile>[CONFIG_DIR]/ber-capacity.js</scriptfile>
+      <active>true</active>
+    </plugin_config>
+  </plugin>
+</simconf>
+""".format(count=count, routing=routing,
+           ports=", legacy ports" if legacy_ports else "", seed=SEED,
+           tx=TX_RANGE, interference=INTERFERENCE_RANGE, ber=ber,
+           sensors=sensors)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Generate the BER capacity scenarios for Cooja")
+    parser.add_argument("-o", "--output", default=os.path.dirname(
+        os.path.abspath(__file__)), help="output directory")
+    parser.add_argument("-s", "--spacing", type=float, default=30.0,
+                        help="grid spacing in meters (default 30)")
+    parser.add_argument("-r", "--routing", choices=ROUTINGS,
+                        default="storing", help="RPL mode (default storing)")
+    parser.add_argument("-l", "--legacy-ports", action="store_true",
+                        help="nodes send from the ports of older firmware")
+    parser.add_argument("nodes", type=int, nargs="*", default=DEFAULT_NODES,
+                        help="sensor node counts (default 10 50 150 300)")
+    args = parser.parse_args()
+
+    for count in args.nodes:
+        path = os.path.join(args.output, scenario_name(count, args.routing,
+                                                       args.legacy_ports))
+        with open(path, "w") as f:
+            f.write(scenario(count, args.spacing, args.routing,
+                             args.legacy_ports))
+        print(path)
+
+
+if __name__ == "__main__":
+    main()
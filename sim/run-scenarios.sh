@@ -0,0 +1,44 @@
+#!/bin/sh
+#
+# Run the capacity scenarios headless and print their RESULT lines.
+#
+# Usage: run-scenarios.sh [nodes ...]     (default: 10 50 150 300)
+#
+# CONTIKI points to the Contiki-NG tree (default: the one the BER Makefile
+# uses). ROUTING picks the RPL mode, storing (default), non-storing or lite;
+# see ../Makefile.routing. Each run keeps its Cooja logs in
+# sim/logs/<nodes>[-<routing>]/. The exit status is non-zero if any scenario
+# failed its limits.
+
+SIM_DIR=$(cd "$(dirname "$0")" && pwd)
+CONTIKI=${CONTIKI:-$SIM_DIR/../../../../contiki-ng}
+COOJA=$CONTIKI/tools/cooja
+ROUTING=${ROUTING:-storing}
+if [ "$ROUTING" = storing ]; then
+  suffix=
+else
+  suffix=-$ROUTING
+fi
+
+status=0
+for nodes in ${@:-10 50 150 300}; do
+  csc=$SIM_DIR/ber-$nodes$suffix.csc
+  logs=$SIM_DIR/logs/$nodes$suffix
+  if [ ! -f "$csc" ]; then
+    echo "$csc not found, run gen-scenarios.py -r $ROUTING $nodes first" >&2
+    status=1
+    continue
+  fi
+  mkdir -p "$logs"
+  "$COOJA/gradlew" --no-watch-fs --quiet -p "$COOJA" run \
+    --args="--no-gui --logdir=$logs $csc" > "$logs/cooja.out" 2>&1
+  result=$?
+  line=$(grep -h "RESULT" "$logs"/*.testlog 2>/dev/null) ||
+    line="RESULT nodes=$nodes none"
+  echo "$ROUTING $line"
+  if [ $result -ne 0 ] || ! grep -q "TEST OK" "$logs"/*.testlog 2>/dev/null; then
+    echo "FAIL ber-$nodes$suffix.csc (see $logs)"
+    status=1
+  fi
+done
+exit $status
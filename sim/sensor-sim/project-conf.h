@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2006, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ */
+
+#ifndef PROJECT_CONF_H_
+#define PROJECT_CONF_H_
+
+/* Reporting period of every emulated node */
+#define SIM_CONF_SEND_INTERVAL (60 * CLOCK_SECOND)
+
+/* Dense grids: keep every neighbor and, in storing mode, the whole subtree */
+#define NBR_TABLE_CONF_MAX_NEIGHBORS        32
+#ifndef NETSTACK_CONF_MAX_ROUTE_ENTRIES
+#define NETSTACK_CONF_MAX_ROUTE_ENTRIES     64
+#endif
+
+/* Same RPL mode as the BER, see ../../Makefile.routing */
+#if BER_CONF_RPL_NON_STORING
+#define RPL_CONF_MOP RPL_MOP_NON_STORING
+#endif
+
+/* Logging; the Cooja script parses the SIM module's "tx" lines */
+#define LOG_CONF_LEVEL_RPL                         LOG_LEVEL_NONE
+#define LOG_CONF_LEVEL_TCPIP                       LOG_LEVEL_NONE
+#define LOG_CONF_LEVEL_IPV6                        LOG_LEVEL_NONE
+#define LOG_CONF_LEVEL_6LOWPAN                     LOG_LEVEL_NONE
+#define LOG_CONF_LEVEL_MAC                         LOG_LEVEL_NONE
+#define TSCH_LOG_CONF_PER_SLOT                     0
+#define SICSLOWPAN_CONF_FRAG 0 /* No fragmentation */
+#define UIP_CONF_BUFFER_SIZE 500
+
+/* Same network and schedule as the BER (../../project-conf.h) */
+#define IEEE802154_CONF_PANID 0xF4D0
+extern struct orchestra_rule ber_root_uplink;
+#if BER_CONF_RPL_NON_STORING
+#define ORCHESTRA_CONF_RULES                                                \
+  {                                                                         \
+    &eb_per_time_source, &ber_root_uplink,                                  \
+    &unicast_per_neighbor_rpl_ns, &default_common                           \
+  }
+#else
+#define ORCHESTRA_CONF_RULES                                                \
+  {                                                                         \
+    &eb_per_time_source, &ber_root_uplink,                                  \
+    &unicast_per_neighbor_rpl_storing, &default_common                      \
+  }
+#endif
+
+#endif
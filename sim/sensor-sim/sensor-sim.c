@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Emulated sensor node for the BER capacity simulations.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Every node sends one of the existing datagram formats (12, 68 or
+ *         76 bytes, chosen by node ID) to the root once per
+ *         SIM_SEND_INTERVAL. The package_number field carries the node ID in
+ *         its upper bits and a per-node counter in the lower ones, so the
+ *         Cooja script can match every record the BER prints against the
+ *         "tx" line of the node that sent it.
+ * @{
+ */
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/netstack.h"
+#include "net/ipv6/simple-udp.h"
+#include "sys/node-id.h"
+#include "lib/random.h"
+#include "ber.h"
+#include "ber-schema.h"
+
+#include "sys/log.h"
+#define LOG_MODULE "SIM"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+
+#ifdef SIM_CONF_SEND_INTERVAL
+#define SIM_SEND_INTERVAL SIM_CONF_SEND_INTERVAL
+#else
+#define SIM_SEND_INTERVAL (60 * CLOCK_SECOND)
+#endif
+
+/* Send from the port pair of node firmware from before the compressible
+   one, for a radio log to compare against */
+#ifdef SIM_CONF_LEGACY_PORTS
+#define SIM_LEGACY_PORTS SIM_CONF_LEGACY_PORTS
+#else
+#define SIM_LEGACY_PORTS 0
+#endif
+
+/* package_number = node ID << SIM_SEQ_BITS | counter */
+#define SIM_SEQ_BITS 20
+#define SIM_SEQ_MASK ((1UL << SIM_SEQ_BITS) - 1)
+
+static struct simple_udp_connection udp_conn;
+static uint8_t payload[76];
+static const uint8_t lengths[] = { 12, 68, 76 };
+
+PROCESS(sensor_sim_process, "Sensor sim");
+AUTOSTART_PROCESSES(&sensor_sim_process);
+/*---------------------------------------------------------------------------*/
+static void
+put_le32(uint8_t *p, uint32_t v)
+{
+  p[0] = v & 0xff;
+  p[1] = (v >> 8) & 0xff;
+  p[2] = (v >> 16) & 0xff;
+  p[3] = (v >> 24) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static void
+fill_payload(const struct ber_payload_type *type, uint32_t package_number)
+{
+  uint8_t i;
+
+  /* Plausible, slowly varying readings; only package_number matters */
+  for(i = 0; i < type->field_count; i++) {
+    put_le32(&payload[type->fields[i].offset],
+             1000 + node_id * 10 + i + random_rand() % 16);
+  }
+  put_le32(&payload[type->fields[type->seq_field].offset], package_number);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(sensor_sim_process, ev, data)
+{
+  static struct etimer periodic_timer;
+  static const struct ber_payload_type *type;
+  static uint32_t seq;
+  uip_ipaddr_t dest;
+  uint32_t package_number;
+
+  PROCESS_BEGIN();
+
+#if SIM_LEGACY_PORTS
+  simple_udp_register(&udp_conn, BER_UDP_LEGACY_CLIENT_PORT, NULL,
+                      BER_UDP_LEGACY_SERVER_PORT, NULL);
+#else
+  simple_udp_register(&udp_conn, BER_UDP_CLIENT_PORT, NULL,
+                      BER_UDP_SERVER_PORT, NULL);
+#endif
+  type = ber_schema_lookup(lengths[node_id % sizeof(lengths)]);
+
+  /* Spread the nodes over the interval, then keep a fixed period */
+  etimer_set(&periodic_timer, random_rand() % SIM_SEND_INTERVAL);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&periodic_timer));
+  etimer_set(&periodic_timer, SIM_SEND_INTERVAL);
+
+  while(1) {
+    /* Readings missed before joining count as lost, as they would be */
+    package_number = ((uint32_t)node_id << SIM_SEQ_BITS) |
+                     (seq++ & SIM_SEQ_MASK);
+    if(NETSTACK_ROUTING.node_is_reachable() &&
+       NETSTACK_ROUTING.get_root_ipaddr(&dest)) {
+      fill_payload(type, package_number);
+      simple_udp_sendto(&udp_conn, payload, type->length, &dest);
+      LOG_INFO("tx %lu\n", (unsigned long)package_number);
+    } else {
+      LOG_INFO("unreachable %lu\n", (unsigned long)package_number);
+    }
+
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&periodic_timer));
+    etimer_reset(&periodic_timer);
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
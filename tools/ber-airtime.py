@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+#
+# Bytes on air per sensor report, before and after the compressible UDP port
+# pair of ber.h (0xF0B0/0xF0B1), with and without a 6LoWPAN context for the
+# field prefix. Computed from the RFC 6282 rules, not captured on air.
+#
+# Usage: ber-airtime.py [-p payload ...] [-r radio.pcap ...]
+#
+# -r reads a radio log instead: a pcap file of IEEE 802.15.4 frames (link
+# type 195 or 230), as Cooja's radio logger or a sniffer saves it. For every
+# report it finds on its way to the BER, it prints how many frames of each
+# length it saw, next to the hop whose computed length matches.
+#
+# The frame is built the way Contiki-NG sends it over TSCH, following RFC
+# 6282: an IEEE 802.15.4-2015 data frame with long addresses and no security,
+# an IPHC header, the RPL hop-by-hop option, and a UDP header compressed with
+# NHC. Nothing is fragmented (SICSLOWPAN_CONF_FRAG is 0), so a report must fit
+# in one 127-byte frame.
+#
+# The MAC header is counted with the destination PAN ID; some frame versions
+# leave it out, which gives 2 more bytes everywhere.
+#
+# Where an address can be compressed depends on the hop:
+#   direct    the sender is a child of the root: both addresses derive from
+#             the link-layer addresses
+#   first     the first of several hops: the root's IID is carried inline
+#   forward   a hop in between: both IIDs are inline, and the hop limit is
+#             no longer the default one
+#   last      the parent of the sender hands the report to the root
+
+import argparse
+import collections
+import struct
+import sys
+
+MAX_FRAME = 127  # aMaxPhyPacketSize
+PHY_OVERHEAD = 6  # Preamble, SFD and PHR
+MAC_OVERHEAD = 2 + 1 + 2 + 8 + 8 + 2  # FCF, seq, PAN ID, dst, src, FCS
+
+IPHC = 2
+RPL_OPTION = 8  # RPI hop-by-hop option, as NHC extension header
+UDP_CHECKSUM = 2
+
+REPORTS = [
+    ("PING", 2),
+    ("CO2", 12),
+    ("legacy", 68),
+    ("IMF4D", 76),
+    ("IMF4D+CO2", 76 + 8),  # With the two advanced fields in the same frame
+]
+
+HOPS = [
+    # name, source IID inline, destination IID inline, hop limit inline
+    ("direct", False, False, False),
+    ("first", False, True, False),
+    ("forward", True, True, True),
+    ("last", True, False, True),
+]
+
+# name, addresses compressed with context 0, UDP ports. Contiki-NG installs
+# fd00::/64 as context 0 by default, so "before" has the context; "no-ctx"
+# shows what a prefix without one costs.
+SETUPS = [
+    ("no-ctx", False, (4321, 1234)),
+    ("before", True, (4321, 1234)),
+    ("after", True, (0xF0B1, 0xF0B0)),
+]
+
+
+def address_bytes(context, iid_inline):
+    """A global fd00::/64 address."""
+    if not context:
+        return 16
+    return 8 if iid_inline else 0
+
+
+def udp_port_bytes(ports):
+    if all(0xF0B0 <= p <= 0xF0BF for p in ports):
+        return 1
+    if any(0xF000 <= p <= 0xF0FF for p in ports):
+        return 3
+    return 4
+
+
+def header_bytes(context, ports, src_inline, dst_inline, hlim_inline):
+    return (IPHC + int(hlim_inline) +
+            address_bytes(context, src_inline) +
+            address_bytes(context, dst_inline) +
+            RPL_OPTION +
+            1 + udp_port_bytes(ports) + UDP_CHECKSUM)
+
+
+LINKTYPE_IEEE802_15_4_WITHFCS = 195
+LINKTYPE_IEEE802_15_4_NOFCS = 230
+FCS = 2
+
+BER_PORTS = (0xF0B0, 1234)  # Destination ports of reports, new and legacy
+
+
+def read_pcap(path):
+    """Yield each frame of a pcap file without its FCS, and its length on
+    air with it."""
+    with open(path, "rb") as f:
+        header = f.read(24)
+        if len(header) < 24:
+            raise ValueError("{}: not a pcap file".format(path))
+        if header[:4] in (b"\xd4\xc3\xb2\xa1", b"\x4d\x3c\xb2\xa1"):
+            order = "<"
+        elif header[:4] in (b"\xa1\xb2\xc3\xd4", b"\xa1\xb2\x3c\x4d"):
+            order = ">"
+        else:
+            raise ValueError("{}: not a pcap file".format(path))
+        linktype = struct.unpack(order + "I", header[20:24])[0] & 0xffff
+        if linktype not in (LINKTYPE_IEEE802_15_4_WITHFCS,
+                            LINKTYPE_IEEE802_15_4_NOFCS):
+            raise ValueError("{}: link type {} is not IEEE 802.15.4".format(
+                path, linktype))
+        while True:
+            record = f.read(16)
+            if len(record) < 16:
+                return
+            incl_len, orig_len = struct.unpack(order + "II", record[8:16])
+            data = f.read(incl_len)
+            if len(data) < incl_len:
+                return
+            if linktype == LINKTYPE_IEEE802_15_4_WITHFCS:
+                data = data[:-FCS]
+            yield data, orig_len + (
+                FCS if linktype == LINKTYPE_IEEE802_15_4_NOFCS else 0)
+
+
+def mac_header_length(frame):
+    """Length of the MAC header of an unsecured data frame, or None."""
+    fcf = frame[0] | frame[1] << 8
+    if fcf & 0x7 != 1 or fcf & 0x8:
+        return None  # Not data, or secured
+    pan_compression = bool(fcf & 0x40)
+    dst_mode = (fcf >> 10) & 3
+    version = (fcf >> 12) & 3
+    src_mode = (fcf >> 14) & 3
+    addr_len = {0: 0, 2: 2, 3: 8}
+    if dst_mode not in addr_len or src_mode not in addr_len:
+        return None
+    pos = 2 if version == 2 and fcf & 0x100 else 3  # Sequence suppression
+    if version < 2:
+        dst_pan = dst_mode != 0
+        src_pan = src_mode != 0 and not pan_compression
+    elif dst_mode == 0 and src_mode == 0:
+        dst_pan, src_pan = pan_compression, False
+    elif src_mode == 0:
+        dst_pan, src_pan = not pan_compression, False
+    elif dst_mode == 0:
+        dst_pan, src_pan = False, not pan_compression
+    elif dst_mode == 3 and src_mode == 3:
+        dst_pan, src_pan = not pan_compression, False
+    else:
+        dst_pan, src_pan = True, not pan_compression
+    pos += 2 * dst_pan + addr_len[dst_mode] + 2 * src_pan + addr_len[src_mode]
+    if version == 2 and fcf & 0x200:
+        # Header IEs up to a termination, then payload IEs if announced
+        payload_ies = False
+        while True:
+            desc = frame[pos] | frame[pos + 1] << 8
+            pos += 2 + (desc & 0x7f)
+            element = (desc >> 7) & 0xff
+            if element in (0x7e, 0x7f):
+                payload_ies = element == 0x7e
+                break
+        while payload_ies:
+            desc = frame[pos] | frame[pos + 1] << 8
+            pos += 2 + (desc & 0x7ff)
+            if (desc >> 11) & 0xf == 0xf:
+                break
+    return pos
+
+
+def iphc_udp(frame, pos):
+    """Ports and payload offset of an IPHC-compressed UDP datagram."""
+    b0, b1 = frame[pos], frame[pos + 1]
+    if b0 & 0xe0 != 0x60:
+        return None
+    pos += 2
+    if b1 & 0x80:
+        pos += 1  # Context identifier
+    pos += {0: 4, 1: 3, 2: 1, 3: 0}[(b0 >> 3) & 3]  # Traffic class, flow
+    inline_nh = None
+    if not b0 & 0x04:
+        inline_nh = frame[pos]
+        pos += 1
+    if b0 & 0x03 == 0:
+        pos += 1  # Hop limit
+    sac, sam = b1 & 0x40, (b1 >> 4) & 3
+    pos += ({0: 0, 1: 8, 2: 2, 3: 0} if sac else
+            {0: 16, 1: 8, 2: 2, 3: 0})[sam]
+    multicast, dac, dam = b1 & 0x08, b1 & 0x04, b1 & 3
+    if multicast:
+        pos += 6 if dac else {0: 16, 1: 6, 2: 4, 3: 1}[dam]
+    else:
+        pos += {0: 0, 1: 8, 2: 2, 3: 0}[dam] if dac else \
+            {0: 16, 1: 8, 2: 2, 3: 0}[dam]
+
+    while True:
+        if inline_nh is None:
+            nhc = frame[pos]
+            if nhc & 0xf0 == 0xe0:  # Extension header
+                pos += 1
+                if not nhc & 0x01:
+                    inline_nh = frame[pos]
+                    pos += 1
+                pos += 1 + frame[pos]
+                continue
+            if nhc & 0xf8 != 0xf0:
+                return None
+            pos += 1
+            ports = nhc & 3
+            if ports == 0:
+                src, dst = struct.unpack(">HH", frame[pos:pos + 4])
+                pos += 4
+            elif ports == 1:
+                src = struct.unpack(">H", frame[pos:pos + 2])[0]
+                dst = 0xF000 | frame[pos + 2]
+                pos += 3
+            elif ports == 2:
+                src = 0xF000 | frame[pos]
+                dst = struct.unpack(">H", frame[pos + 1:pos + 3])[0]
+                pos += 3
+            else:
+                src = 0xF0B0 | frame[pos] >> 4
+                dst = 0xF0B0 | frame[pos] & 0xf
+                pos += 1
+            if not nhc & 0x04:
+                pos += UDP_CHECKSUM
+            return src, dst, pos
+        if inline_nh in (0, 43, 60):  # Uncompressed extension header
+            inline_nh, length = frame[pos], frame[pos + 1]
+            pos += (length + 1) * 8
+            continue
+        if inline_nh != 17:
+            return None
+        src, dst = struct.unpack(">HH", frame[pos:pos + 4])
+        return src, dst, pos + 8
+
+
+def port_name(port):
+    return "0x{:04X}".format(port) if port >= 0xF000 else str(port)
+
+
+def radio_log(path, reports):
+    """Frame lengths of the reports to the BER in a radio log."""
+    seen = collections.defaultdict(collections.Counter)
+    for frame, mpdu in read_pcap(path):
+        try:
+            pos = mac_header_length(frame)
+            udp = pos is not None and iphc_udp(frame, pos)
+        except IndexError:
+            continue  # Truncated, or not what the header claimed
+        if not udp or udp[1] not in BER_PORTS:
+            continue
+        src, dst, pos = udp
+        seen[(src, dst, len(frame) - pos)][PHY_OVERHEAD + mpdu] += 1
+
+    print("Reports to the BER in {} (PHY included):".format(path))
+    print("{:<14} {:<10} {:>7}  {}".format("ports", "report", "payload",
+                                           "on air x frames (computed hop)"))
+    names = dict((p, r) for r, p in reversed(reports))
+    for (src, dst, payload), lengths in sorted(seen.items()):
+        setups = [s for s in SETUPS if s[2] == (src, dst)] or \
+            [("", True, (src, dst))]
+        cells = []
+        for length, count in sorted(lengths.items()):
+            match = [(s[0] + "/" if len(setups) > 1 else "") + h[0]
+                     for s in setups for h in HOPS
+                     if PHY_OVERHEAD + MAC_OVERHEAD + payload +
+                     header_bytes(s[1], s[2], *h[1:]) == length]
+            cells.append("{} x{} ({})".format(length, count,
+                                              ", ".join(match) or "none"))
+        print("{:<14} {:<10} {:>7}  {}".format(
+            port_name(src) + "/" + port_name(dst),
+            names.get(payload, "other"), payload, ", ".join(cells)))
+    if not seen:
+        print("  none")
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Bytes on air per BER sensor report")
+    parser.add_argument("-p", "--payload", type=int, action="append",
+                        help="payload length to add to the report table")
+    parser.add_argument("-r", "--radio-log", action="append",
+                        help="pcap file of 802.15.4 frames to measure")
+    args = parser.parse_args()
+
+    reports = REPORTS + [("custom", p) for p in (args.payload or [])]
+    if args.radio_log:
+        for path in args.radio_log:
+            try:
+                radio_log(path, reports)
+            except (OSError, ValueError) as e:
+                sys.exit(str(e))
+        return
+
+    print("Header bytes (IPv6, RPL option and UDP, after 6LoWPAN) per hop:")
+    print("{:<8}".format("") + "".join("{:>9}".format(h[0]) for h in HOPS))
+    for name, context, ports in SETUPS:
+        print("{:<8}".format(name) + "".join(
+            "{:>9}".format(header_bytes(context, ports, *h[1:]))
+            for h in HOPS))
+    print()
+
+    print("Bytes on air per report from a child of the root (PHY "
+          "included); '-' does not fit in one frame:")
+    print("{:<10} {:>7}".format("report", "payload") +
+          "".join("{:>9}".format(s[0]) for s in SETUPS) +
+          "{:>7}  {}".format("saved", "too long after, at"))
+    for report, payload in reports:
+        sizes = []
+        for name, context, ports in SETUPS:
+            mpdu = MAC_OVERHEAD + header_bytes(context, ports,
+                                               *HOPS[0][1:]) + payload
+            sizes.append(PHY_OVERHEAD + mpdu if mpdu <= MAX_FRAME else None)
+        cells = "".join("{:>9}".format(s if s is not None else "-")
+                        for s in sizes)
+        saved = (sizes[1] - sizes[2] if None not in sizes[1:] else "")
+        context, ports = SETUPS[-1][1:]
+        too_long = [h[0] for h in HOPS
+                    if MAC_OVERHEAD + header_bytes(context, ports, *h[1:]) +
+                    payload > MAX_FRAME]
+        print("{:<10} {:>7}".format(report, payload) + cells +
+              "{:>7}  {}".format(saved, ", ".join(too_long)))
+    print()
+
+    print("Largest payload in one frame:")
+    print("{:<8}".format("") + "".join("{:>9}".format(h[0]) for h in HOPS))
+    for name, context, ports in SETUPS:
+        print("{:<8}".format(name) + "".join(
+            "{:>9}".format(MAX_FRAME - MAC_OVERHEAD -
+                           header_bytes(context, ports, *h[1:]))
+            for h in HOPS))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Throughput benchmark for the BER record pipeline.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Replays a stream of datagrams through the same code path the
+ *         firmware runs for every received packet (ber_record_input(), then
+ *         ber_record_output() as ber_output_process drains the queue) and
+ *         reports records per second, bytes emitted per record and CPU
+ *         cycles per record.
+ *
+ *         The stream is either synthetic (PING, CO2, energest, legacy and
+ *         IMF4D datagrams round-robin over a set of node addresses) or read
+ *         from a recording. A recording is a sequence of
+ *         [len (1 byte)][sender address (16 bytes)][datagram (len bytes)].
+ *         With -f sparse or -f varint, synthetic sensor records are sent
+ *         with the versioned header of ber-wire.h (sparse leaves out every
+ *         fourth field); with -f delta, IMF4D records are delta-coded
+ *         against the previous one of the same node.
+ *
+ *         Time is simulated: every node sends once a minute, so the stream
+ *         advances by a minute per round over all nodes. With -a, one extra
+ *         node floods that many datagrams after every regular one, to see
+ *         what the admission control of ber-rate.h lets through.
+ *
+ *         When libber.a is built with BER_CONF_SUMMARY, the summaries of
+ *         ber-summary.h are written every -S simulated minutes (15 by
+ *         default) and at the end of the stream.
+ *
+ *         Usage: ber-bench [-m json|ndjson|csv|binary]
+ *                          [-f legacy|sparse|varint|delta]
+ *                          [-n records]
+ *                          [-N nodes] [-a flood] [-r recording] [-w recording]
+ *                          [-o output] [-S minutes]
+ *
+ *         Formatted output goes to \p output (a temporary file by default)
+ *         and the report to stderr.
+ */
+#include "ber.h"
+#include "ber-frame.h"
+#include "ber-prof.h"
+#include "ber-rate.h"
+#include "ber-record.h"
+#include "ber-schema.h"
+#include "ber-summary.h"
+#include "ber-time.h"
+#include "ber-wire.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_CYCLES 1
+#endif
+
+#define ENERGEST_LEN 32
+#define IMF4D_LEN 76
+#define DELTA_KEYFRAME_INTERVAL 16
+
+struct datagram {
+  uint8_t addr[BER_FRAME_ADDR_SIZE];
+  uint8_t len;
+  uint8_t data[BER_FRAME_MAX_PAYLOAD];
+};
+
+/* What a node last sent, for -f delta */
+struct delta_ref {
+  unsigned long count;
+  uint8_t seq;
+  uint8_t data[IMF4D_LEN];
+};
+
+/* The datagram lengths the BER receives, in the order they are generated */
+static const uint8_t synthetic_lengths[] = { 2, 12, ENERGEST_LEN, 68, 76 };
+
+/* Simulated time in milliseconds, see ber_rate_set_clock() and
+   ber_time_set_clock() */
+static uint32_t now_ms;
+
+/*---------------------------------------------------------------------------*/
+static void
+usage(const char *prog)
+{
+  fprintf(stderr, "Usage: %s [-m json|ndjson|csv|binary] "
+          "[-f legacy|sparse|varint|delta]\n       [-n records] [-N nodes] "
+          "[-a flood] [-r recording] [-w recording] [-o output]\n"
+          "       [-S minutes]\n", prog);
+  exit(EXIT_FAILURE);
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+sim_clock(void)
+{
+  return now_ms;
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+sim_slots(void)
+{
+  return (uint64_t)now_ms * 1000 / BER_TIME_CLOCK_SLOT_US;
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_i32_le(uint8_t *buf, int32_t v)
+{
+  uint32_t u = (uint32_t)v;
+  buf[0] = u & 0xff;
+  buf[1] = (u >> 8) & 0xff;
+  buf[2] = (u >> 16) & 0xff;
+  buf[3] = (u >> 24) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static void
+make_synthetic(struct datagram *d, unsigned long i, unsigned nodes)
+{
+  const struct ber_payload_type *type;
+  unsigned node = i % nodes;
+  /* Every node goes through all formats, one per round */
+  unsigned long round = i / nodes;
+  uint16_t off;
+
+  /* fd00::212:4b00:<node>, the way the field deployment numbers nodes */
+  memset(d->addr, 0, sizeof(d->addr));
+  d->addr[0] = 0xfd;
+  d->addr[8] = 0x02;
+  d->addr[9] = 0x12;
+  d->addr[10] = 0x4b;
+  d->addr[14] = (node + 1) >> 8;
+  d->addr[15] = (node + 1) & 0xff;
+
+  d->len = synthetic_lengths[(round + node) % sizeof(synthetic_lengths)];
+  /* A steady level per node and word plus a few units of noise, the way
+     sensor readings change between two reports */
+  for(off = 0; off + 4 <= d->len; off += 4) {
+    put_i32_le(&d->data[off],
+               (int32_t)(((node + 1) * 2654435761u ^ (off + 1) * 40503u) %
+                         200000) - 100000 + rand() % 21 - 10);
+  }
+  if(d->len < 4) {
+    memset(d->data, 0, d->len);
+  }
+
+  /* One energest period per round: 60 s at 32768 ticks/s, ~1% radio */
+  if(d->len == ENERGEST_LEN) {
+    static const uint32_t energest[] = {
+      58982, 1906065, 0, 4915, 14746, 1966080, 60, 0
+    };
+    for(off = 0; off < ENERGEST_LEN / 4; off++) {
+      uint32_t v = off == 7 ? (uint32_t)round : energest[off];
+      d->data[off * 4] = v >> 24;
+      d->data[off * 4 + 1] = (v >> 16) & 0xff;
+      d->data[off * 4 + 2] = (v >> 8) & 0xff;
+      d->data[off * 4 + 3] = v & 0xff;
+    }
+    return;
+  }
+
+  /* Consecutive sequence numbers, so nothing is dropped as a duplicate */
+  type = ber_schema_lookup(d->len);
+  if(type != NULL && type->seq_field >= 0) {
+    put_i32_le(&d->data[type->fields[type->seq_field].offset],
+               (int32_t)round);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int32_t
+get_i32_le(const uint8_t *buf)
+{
+  return (int32_t)((uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+                   ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24));
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_varint(uint8_t **p, int32_t v)
+{
+  uint32_t u = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+
+  while(u >= 0x80) {
+    *(*p)++ = (u & 0x7f) | 0x80;
+    u >>= 7;
+  }
+  *(*p)++ = u;
+}
+/*---------------------------------------------------------------------------*/
+/* Re-encode a fixed-layout datagram with the header of ber-wire.h. The
+   sparse format leaves out every fourth field; a delta is taken against
+   prev, whose package_number ends in ref_seq. */
+static void
+encode_wire(struct datagram *d, uint8_t version, const uint8_t *prev,
+            uint8_t ref_seq, int sparse)
+{
+  const struct ber_payload_type *type = ber_schema_lookup(d->len);
+  uint8_t fixed[sizeof(d->data)];
+  uint8_t *p = &d->data[BER_WIRE_HEADER_SIZE];
+  uint8_t *mask_at;
+  uint32_t mask = 0;
+  uint16_t off;
+  uint8_t words;
+  int32_t v;
+  uint8_t i;
+
+  if(type == NULL || type->field_count == 0) {
+    return;
+  }
+  memcpy(fixed, d->data, d->len);
+  if(version == BER_WIRE_VERSION_DELTA) {
+    *p++ = ref_seq;
+  }
+  mask_at = p;
+  p += BER_WIRE_MASK_SIZE(type);
+
+  for(i = 0; i < type->field_count; i++) {
+    if(sparse && i % 4 == 3 && i != type->seq_field) {
+      continue;
+    }
+    mask |= 1UL << i;
+    off = type->fields[i].offset;
+    words = type->fields[i].kind == BER_FIELD_SPLIT ? 2 : 1;
+    for(; words > 0; words--, off += 4) {
+      v = get_i32_le(&fixed[off]);
+      if(version == BER_WIRE_VERSION_SPARSE) {
+        put_i32_le(p, v);
+        p += 4;
+      } else {
+        put_varint(&p, version == BER_WIRE_VERSION_DELTA ?
+                   (int32_t)((uint32_t)v - (uint32_t)get_i32_le(&prev[off])) :
+                   v);
+      }
+    }
+  }
+  for(i = 0; i < BER_WIRE_MASK_SIZE(type); i++) {
+    mask_at[i] = mask >> (8 * i);
+  }
+  d->data[0] = BER_WIRE_MAGIC;
+  d->data[1] = BER_WIRE_VERSION_TYPE(version, type->type);
+  d->len = p - d->data;
+  d->data[2] = d->len - BER_WIRE_HEADER_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* IMF4D records of each node as deltas, with a full record every
+   DELTA_KEYFRAME_INTERVAL of them. The other formats stay legacy: the BER
+   keeps only one reference per node. */
+static void
+encode_delta(struct datagram *d, struct delta_ref *ref, unsigned long seq)
+{
+  uint8_t fixed[IMF4D_LEN];
+
+  if(d->len != IMF4D_LEN) {
+    return;
+  }
+  memcpy(fixed, d->data, IMF4D_LEN);
+  if(ref->count++ % DELTA_KEYFRAME_INTERVAL == 0) {
+    encode_wire(d, BER_WIRE_VERSION_SPARSE, NULL, 0, 0);
+  } else {
+    encode_wire(d, BER_WIRE_VERSION_DELTA, ref->data, ref->seq, 0);
+  }
+  memcpy(ref->data, fixed, IMF4D_LEN);
+  ref->seq = seq & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static int
+read_recorded(FILE *in, struct datagram *d)
+{
+  int c = fgetc(in);
+
+  if(c == EOF) {
+    return 0;
+  }
+  d->len = (uint8_t)c;
+  if(d->len > sizeof(d->data) ||
+     fread(d->addr, 1, sizeof(d->addr), in) != sizeof(d->addr) ||
+     fread(d->data, 1, d->len, in) != d->len) {
+    fprintf(stderr, "Truncated or malformed recording\n");
+    return 0;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+write_recorded(FILE *out, const struct datagram *d)
+{
+  fputc(d->len, out);
+  fwrite(d->addr, 1, sizeof(d->addr), out);
+  fwrite(d->data, 1, d->len, out);
+}
+/*---------------------------------------------------------------------------*/
+/* Block writes, like dbg_send_bytes() on the board */
+static void
+write_stdout(const uint8_t *buf, size_t len)
+{
+  fwrite(buf, 1, len, stdout);
+}
+/*---------------------------------------------------------------------------*/
+/* What ber_output_process does when the summary window closes */
+static void
+write_summaries(void)
+{
+  const struct ber_summary *s;
+  uint8_t count = 0;
+
+  for(uint8_t i = 0; i < BER_SUMMARY_SLOTS; i++) {
+    if((s = ber_summary_get(i)) != NULL) {
+      ber_record_summary(s, count++ == 0);
+      ber_summary_clear(i);
+    }
+  }
+  ber_record_summary_end(count);
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+cycles(void)
+{
+#ifdef HAVE_CYCLES
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+  const char *mode = "json";
+  const char *format = "legacy";
+  const char *record_in = NULL;
+  const char *record_out = NULL;
+  const char *output = NULL;
+  unsigned long count = 100000;
+  unsigned nodes = 16;
+  unsigned flood = 0;
+  unsigned window = 15;
+  uint32_t window_end;
+  FILE *in = NULL;
+  FILE *rec = NULL;
+  FILE *tmp;
+  struct datagram d;
+  struct ber_record *r;
+  struct timespec t0, t1;
+  uint64_t c0, c1;
+  unsigned long received = 0;
+  unsigned long queued = 0;
+  unsigned long written = 0;
+  unsigned long flooded = 0;
+  unsigned long flood_queued = 0;
+  unsigned long datagram_bytes = 0;
+  struct delta_ref *refs;
+  long bytes;
+  double secs;
+  int opt;
+
+  while((opt = getopt(argc, argv, "m:f:n:N:a:r:w:o:S:")) != -1) {
+    switch(opt) {
+    case 'm':
+      mode = optarg;
+      break;
+    case 'f':
+      format = optarg;
+      break;
+    case 'n':
+      count = strtoul(optarg, NULL, 0);
+      break;
+    case 'N':
+      nodes = (unsigned)strtoul(optarg, NULL, 0);
+      break;
+    case 'a':
+      flood = (unsigned)strtoul(optarg, NULL, 0);
+      break;
+    case 'r':
+      record_in = optarg;
+      break;
+    case 'w':
+      record_out = optarg;
+      break;
+    case 'o':
+      output = optarg;
+      break;
+    case 'S':
+      window = (unsigned)strtoul(optarg, NULL, 0);
+      break;
+    default:
+      usage(argv[0]);
+    }
+  }
+
+  if(strcmp(mode, "json") == 0) {
+    ber_set_output_mode(BER_OUTPUT_JSON);
+  } else if(strcmp(mode, "ndjson") == 0) {
+    ber_set_output_mode(BER_OUTPUT_NDJSON);
+  } else if(strcmp(mode, "csv") == 0) {
+    ber_set_output_mode(BER_OUTPUT_CSV);
+  } else if(strcmp(mode, "binary") == 0) {
+    ber_set_output_mode(BER_OUTPUT_BINARY);
+  } else {
+    usage(argv[0]);
+  }
+  if(strcmp(format, "legacy") != 0 && strcmp(format, "sparse") != 0 &&
+     strcmp(format, "varint") != 0 && strcmp(format, "delta") != 0) {
+    usage(argv[0]);
+  }
+  /* The flooding node takes the address after the last regular one */
+  if(nodes == 0 || nodes > 0xfffe - (flood > 0)) {
+    usage(argv[0]);
+  }
+  if(window == 0) {
+    usage(argv[0]);
+  }
+  window_end = window * 60000UL;
+  if((refs = calloc(nodes, sizeof(*refs))) == NULL) {
+    perror("calloc");
+    return EXIT_FAILURE;
+  }
+
+  if(record_in != NULL && (in = fopen(record_in, "rb")) == NULL) {
+    perror(record_in);
+    return EXIT_FAILURE;
+  }
+  if(record_out != NULL && (rec = fopen(record_out, "wb")) == NULL) {
+    perror(record_out);
+    return EXIT_FAILURE;
+  }
+
+  /* stdout is where the firmware's UART output goes; keep it as a file so
+     the bytes can be counted */
+  fflush(stdout);
+  if(output != NULL) {
+    if(freopen(output, "w", stdout) == NULL) {
+      perror(output);
+      return EXIT_FAILURE;
+    }
+  } else {
+    if((tmp = tmpfile()) == NULL || dup2(fileno(tmp), STDOUT_FILENO) < 0) {
+      perror("tmpfile");
+      return EXIT_FAILURE;
+    }
+  }
+  setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+  ber_record_set_writer(write_stdout);
+  ber_rate_set_clock(sim_clock);
+  ber_time_set_clock(sim_slots);
+
+  srand(1);
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  c0 = cycles();
+
+  while(in != NULL ? read_recorded(in, &d) : received < count) {
+    if(in == NULL) {
+      make_synthetic(&d, received, nodes);
+      if(strcmp(format, "sparse") == 0) {
+        encode_wire(&d, BER_WIRE_VERSION_SPARSE, NULL, 0, 1);
+      } else if(strcmp(format, "varint") == 0) {
+        encode_wire(&d, BER_WIRE_VERSION_VARINT, NULL, 0, 0);
+      } else if(strcmp(format, "delta") == 0) {
+        encode_delta(&d, &refs[received % nodes], received / nodes);
+      }
+      if(rec != NULL) {
+        write_recorded(rec, &d);
+      }
+    }
+    received++;
+    datagram_bytes += d.len;
+    now_ms = (uint32_t)((unsigned long long)received * 60000 / nodes);
+
+    queued += ber_record_input(d.addr, d.data, d.len);
+    for(unsigned i = 0; in == NULL && i < flood; i++) {
+      make_synthetic(&d, flooded * (nodes + 1) + nodes, nodes + 1);
+      flooded++;
+      flood_queued += ber_record_input(d.addr, d.data, d.len);
+    }
+    while((r = ber_queue_peek()) != NULL) {
+      ber_record_output(r, 0);
+      ber_queue_pop();
+      written++;
+    }
+    if(BER_SUMMARY && now_ms >= window_end) {
+      write_summaries();
+      window_end += window * 60000UL;
+    }
+  }
+  if(BER_SUMMARY) {
+    write_summaries();
+  }
+  fflush(stdout);
+
+  c1 = cycles();
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  bytes = lseek(STDOUT_FILENO, 0, SEEK_CUR);
+  secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+  fprintf(stderr, "mode:            %s\n", mode);
+  fprintf(stderr, "datagrams:       %lu (%lu queued, %lu written)\n",
+          received, queued, written);
+  fprintf(stderr, "dropped:         %lu unknown length, %lu duplicates, "
+          "%lu without reference\n",
+          (unsigned long)ber_record_get_stats()->unknown,
+          (unsigned long)ber_record_get_stats()->duplicates,
+          (unsigned long)ber_record_get_stats()->no_reference);
+  if(flooded > 0) {
+    fprintf(stderr, "flood:           %lu datagrams, %lu queued%s\n",
+            flooded, flood_queued,
+            BER_RATE ? "" : " (rate limiting disabled)");
+  }
+#if BER_SUMMARY
+  fprintf(stderr, "summaries:       %lu records in %lu windows of %u min, "
+          "%lu over threshold, %lu without slot\n",
+          (unsigned long)ber_summary_get_stats()->summarized,
+          (unsigned long)ber_summary_get_stats()->windows, window,
+          (unsigned long)ber_summary_get_stats()->over_threshold,
+          (unsigned long)ber_summary_get_stats()->no_slot);
+#endif
+#if BER_RATE
+  fprintf(stderr, "rate limited:    %lu ping, %lu data, %lu energest\n",
+          (unsigned long)ber_record_get_stats()->rate_limited[BER_RATE_PING],
+          (unsigned long)ber_record_get_stats()->rate_limited[BER_RATE_DATA],
+          (unsigned long)
+          ber_record_get_stats()->rate_limited[BER_RATE_ENERGEST]);
+#endif
+  fprintf(stderr, "elapsed:         %.3f s\n", secs);
+  if(received > 0 && secs > 0) {
+    fprintf(stderr, "records/sec:     %.0f\n", received / secs);
+    fprintf(stderr, "datagram bytes:  %.1f per record\n",
+            (double)datagram_bytes / received);
+    fprintf(stderr, "bytes/record:    %.1f\n", (double)bytes / received);
+#ifdef HAVE_CYCLES
+    fprintf(stderr, "cycles/record:   %.0f\n", (double)(c1 - c0) / received);
+#else
+    fprintf(stderr, "cycles/record:   n/a on this architecture\n");
+#endif
+  }
+
+  /* Per-stage histograms, when libber.a was built with BER_CONF_PROF */
+  for(uint8_t stage = 0; stage < BER_PROF_STAGES; stage++) {
+    const struct ber_prof_hist *h = ber_prof_get(stage);
+    if(h == NULL || h->count == 0) {
+      continue;
+    }
+    fprintf(stderr, "%-6s n=%lu avg=%.2f us max=%lu us |",
+            ber_prof_stage_name(stage), (unsigned long)h->count,
+            (double)h->total / h->count, (unsigned long)h->max);
+    for(uint8_t i = 0; i < BER_PROF_BUCKETS; i++) {
+      fprintf(stderr, " %lu", (unsigned long)h->buckets[i]);
+    }
+    fprintf(stderr, "\n");
+  }
+
+  if(in != NULL) {
+    fclose(in);
+  }
+  if(rec != NULL) {
+    fclose(rec);
+  }
+  free(refs);
+  return EXIT_SUCCESS;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Host-side decoder for the BER binary output mode.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Reads the BER UART stream (a serial device, a capture file or
+ *         stdin), picks out the COBS frames written in BER_OUTPUT_BINARY
+ *         mode and prints the same JSON that the firmware prints in
+ *         BER_OUTPUT_JSON mode. Any text between frames (boot banner, logs)
+ *         is skipped.
+ *
+ *         Records stamped with their reception time (BER_CONF_TIME) keep
+ *         it as "asn". With -t, each one also gets a "time" member, in Unix
+ *         seconds: the host clock at the arrival of an anchor, plus the
+ *         slots between the anchor and the record. Of the last few anchors
+ *         the one that reached us quickest is used, which takes the UART
+ *         and scheduling delays out. This is only meaningful while reading
+ *         the live stream.
+ *
+ *         Usage: ber-decode [-t] [file]
+ */
+#include "ber-frame.h"
+#include "ber-node.h"
+#include "ber-prof.h"
+#include "ber-schema.h"
+#include "ber-summary.h"
+#include "ber-time.h"
+#include "ber-wire.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Anchors the host clock is taken from, the quickest of these many */
+#define ANCHOR_WINDOW 8
+
+static unsigned long frames_ok;
+static unsigned long frames_bad;
+
+/* Host clock minus network time at each anchor, in microseconds */
+static int wall_time;
+static long long anchor_offsets[ANCHOR_WINDOW];
+static uint8_t anchor_count;
+static uint8_t anchor_next;
+static uint64_t anchor_asn;
+static uint32_t anchor_slot_us;
+static long long frame_arrival_us;
+
+/*---------------------------------------------------------------------------*/
+/* Node ID frames only carry the ID; the address comes from an earlier frame
+   of the same node that carried it (NODE_STATS, NODE_ENERGY) */
+static const char *
+node_addr(const struct ber_frame *f)
+{
+  struct ber_node *n;
+
+  if(f->version == BER_FRAME_VERSION) {
+    return ber_node_addr_str(ber_node_lookup(f->addr));
+  }
+  for(uint8_t i = 0; i < BER_NODE_TABLE_SIZE; i++) {
+    if((n = ber_node_get(i)) != NULL && n->id == f->node_id) {
+      return ber_node_addr_str(n);
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static long long
+wall_clock_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+/*---------------------------------------------------------------------------*/
+static void
+anchor_update(const struct ber_frame *f, uint32_t slot_us)
+{
+  /* The BER restarted its network time; older anchors no longer apply */
+  if(f->asn < anchor_asn || slot_us != anchor_slot_us) {
+    anchor_count = 0;
+    anchor_next = 0;
+  }
+  anchor_asn = f->asn;
+  anchor_slot_us = slot_us;
+  anchor_offsets[anchor_next] = frame_arrival_us -
+    (long long)(f->asn * slot_us);
+  anchor_next = (anchor_next + 1) % ANCHOR_WINDOW;
+  if(anchor_count < ANCHOR_WINDOW) {
+    anchor_count++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Add the "time" member to a record object, if there has been an anchor */
+static void
+add_time(char *json, size_t size, uint64_t asn)
+{
+  size_t len = strlen(json);
+  long long offset;
+  long long t;
+
+  if(!wall_time || anchor_count == 0 || len < 2 ||
+     strcmp(&json[len - 2], "\n}") != 0) {
+    return;
+  }
+  offset = anchor_offsets[0];
+  for(uint8_t i = 1; i < anchor_count; i++) {
+    if(anchor_offsets[i] < offset) {
+      offset = anchor_offsets[i];
+    }
+  }
+  t = (long long)(asn * anchor_slot_us) + offset;
+  snprintf(&json[len - 2], size - (len - 2), ",\n    \"time\":%lld.%03lld\n}",
+           t / 1000000, t % 1000000 / 1000);
+}
+/*---------------------------------------------------------------------------*/
+/* Summaries have the layout of the format they summarize, see ber-summary.h */
+static void
+print_summary(const struct ber_frame *f)
+{
+  char json[1024];
+  char id[8];
+  const char *ipv6 = node_addr(f);
+  struct ber_json w;
+
+  snprintf(id, sizeof(id), "%u", f->node_id);
+  ber_json_init(&w, json, sizeof(json));
+  if(ber_summary_write_json(&w, f->payload, f->len,
+                            ipv6 != NULL ? "ipv6" : "node_id",
+                            ipv6 != NULL ? ipv6 : id,
+                            f->has_asn ? &f->asn : NULL) < 0 ||
+     ber_json_result(&w) < 0) {
+    fprintf(stderr, "ber-decode: malformed summary\n");
+    return;
+  }
+  if(f->has_asn) {
+    add_time(json, sizeof(json), f->asn);
+  }
+  printf("\nSUMMARY_START\n[\n%s\n]\nSUMMARY_END\n", json);
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_frame(const struct ber_frame *f)
+{
+  char json[1024];
+  char id[8];
+  const struct ber_payload_type *type = ber_schema_get(f->type);
+  uint32_t present = BER_SCHEMA_ALL_FIELDS;
+  const char *ipv6;
+
+  if(f->type == BER_FRAME_TYPE_SUMMARY) {
+    print_summary(f);
+    return;
+  }
+  if(type == NULL || (type->field_count > 0 && f->len < type->length)) {
+    fprintf(stderr, "ber-decode: unknown record type %u\n", f->type);
+    return;
+  }
+
+  /* Records with missing fields carry their presence bitmap at the end */
+  if(type->field_count > 0 &&
+     f->len == type->length + BER_WIRE_MASK_SIZE(type)) {
+    present = 0;
+    for(uint8_t i = 0; i < BER_WIRE_MASK_SIZE(type); i++) {
+      present |= (uint32_t)f->payload[type->length + i] << (8 * i);
+    }
+  }
+
+  if(type->type == BER_FRAME_TYPE_ANCHOR) {
+    ber_schema_to_json_object_at(json, sizeof(json), type, f->payload,
+                                 present, "clock",
+                                 ber_time_source_name(f->node_id), f->asn);
+    printf("\nANCHOR_START\n%s\nANCHOR_END\n", json);
+    anchor_update(f, (uint32_t)ber_schema_field_value(&type->fields[0],
+                                                       f->payload));
+    return;
+  }
+  if(type->type == BER_FRAME_TYPE_PROF) {
+    ber_schema_to_json_object_as(json, sizeof(json), type, f->payload,
+                                 present, "stage",
+                                 ber_prof_stage_name(f->node_id));
+    printf("\nPROF_START\n[\n%s\n]\nPROF_END\n", json);
+    return;
+  }
+
+  ipv6 = node_addr(f);
+  snprintf(id, sizeof(id), "%u", f->node_id);
+
+  if(type->field_count == 0) {
+    printf("\n\rPING received from: %s \n\r\n", ipv6 != NULL ? ipv6 : id);
+    return;
+  }
+  if(type->type == BER_FRAME_TYPE_STORED) {
+    ber_schema_to_json_object_as(json, sizeof(json), type, f->payload,
+                                 present, ipv6 != NULL ? "ipv6" : "node_id",
+                                 ipv6 != NULL ? ipv6 : id);
+    printf("\nSTORED_START\n%s\nSTORED_END\n", json);
+    return;
+  }
+  if(f->has_asn) {
+    ber_schema_to_json_object_at(json, sizeof(json), type, f->payload,
+                                 present, ipv6 != NULL ? "ipv6" : "node_id",
+                                 ipv6 != NULL ? ipv6 : id, f->asn);
+    add_time(json, sizeof(json), f->asn);
+    printf("\nJSON_START\n%s\nJSON_END\n", json);
+    return;
+  }
+  if(ipv6 == NULL) {
+    ber_schema_to_json_object_as(json, sizeof(json), type, f->payload,
+                                 present, "node_id", id);
+    printf("\nJSON_START\n%s\nJSON_END\n", json);
+    return;
+  }
+  if(type->type == BER_FRAME_TYPE_NODE_STATS) {
+    ber_schema_to_json_object(json, sizeof(json), type, f->payload, ipv6);
+    printf("\nNODE_STATS_START\n[\n%s\n]\nNODE_STATS_END\n", json);
+    return;
+  }
+  if(type->type == BER_FRAME_TYPE_NODE_ENERGY) {
+    ber_schema_to_json_object(json, sizeof(json), type, f->payload, ipv6);
+    printf("\nENERGY_START\n[\n%s\n]\nENERGY_END\n", json);
+    return;
+  }
+  ber_schema_to_json(json, sizeof(json), type, f->payload, present, ipv6);
+  fputs(json, stdout);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  FILE *in = stdin;
+  uint8_t buf[BER_FRAME_MAX_ENCODED_SIZE];
+  size_t len = 0;
+  int overflow = 0;
+  int c;
+  struct ber_frame frame;
+
+  while((c = getopt(argc, argv, "t")) != -1) {
+    if(c == 't') {
+      wall_time = 1;
+    } else {
+      fprintf(stderr, "Usage: %s [-t] [file]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if(optind < argc && (in = fopen(argv[optind], "rb")) == NULL) {
+    perror(argv[optind]);
+    return EXIT_FAILURE;
+  }
+
+  while((c = fgetc(in)) != EOF) {
+    if(c != BER_FRAME_DELIMITER) {
+      if(len < sizeof(buf)) {
+        buf[len++] = c;
+      } else {
+        overflow = 1;
+      }
+      continue;
+    }
+    if(len == 0) {
+      continue;
+    }
+    frame_arrival_us = wall_clock_us();
+    if(!overflow && ber_frame_decode(buf, len, &frame) == 0) {
+      print_frame(&frame);
+      frames_ok++;
+    } else {
+      /* Text output between frames also ends up here */
+      frames_bad++;
+    }
+    fflush(stdout);
+    len = 0;
+    overflow = 0;
+  }
+
+  fprintf(stderr, "ber-decode: %lu frames decoded, %lu skipped\n",
+          frames_ok, frames_bad);
+  if(in != stdin) {
+    fclose(in);
+  }
+  return EXIT_SUCCESS;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,907 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Host-side ingest daemon for the BER UART stream.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Reads the BER UART (a serial device, or a pty, pipe or capture
+ *         file standing in for it) and writes one record per line: the
+ *         objects of pretty JSON blocks (JSON_START/JSON_END, NODE_STATS,
+ *         ENERGY, ... and batches) compacted onto one line each, NDJSON and
+ *         CSV lines as they are, and binary frames (with -m binary) as the
+ *         lines BER_OUTPUT_NDJSON would have written. Log lines, banners
+ *         and anything that does not parse are counted and dropped.
+ *
+ *         The input is read with non-blocking I/O into a ring buffer and
+ *         split at line ends (or at frame delimiters) in a single pass;
+ *         records are formatted straight into the output batch, so nothing
+ *         is allocated per record. A batch is written when it holds -B
+ *         kilobytes or its oldest record is -F milliseconds old, either to
+ *         a file that is rotated every -R megabytes (file, file.1, ...,
+ *         file.K), to a local stream socket (reconnected once a second
+ *         while nobody listens), or to stdout. While the output cannot
+ *         keep up, the ring fills and reading stops, so the serial driver
+ *         holds the rest.
+ *
+ *         Throughput, CPU use and error counters go to stderr every -i
+ *         seconds and at exit. The input ends at end of file, or when a
+ *         serial device or pty goes away.
+ *
+ *         Usage: ber-ingest [-m text|binary] [-b baud]
+ *                           [-o file [-R megabytes] [-k files] | -u socket]
+ *                           [-B kilobytes] [-F milliseconds] [-i seconds]
+ *                           [device]
+ */
+#include "ber-frame.h"
+#include "ber-json.h"
+#include "ber-node.h"
+#include "ber-prof.h"
+#include "ber-schema.h"
+#include "ber-summary.h"
+#include "ber-time.h"
+#include "ber-wire.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RING_SIZE  (64 * 1024) /* Power of two */
+#define RING_MASK  (RING_SIZE - 1)
+#define BATCH_SIZE (256 * 1024)
+
+/* Longest line or frame; a record never comes out longer than this */
+#define MAX_UNIT 4096
+
+#define MAX_MARKER 32
+#define RECONNECT_MS 1000
+
+struct ingest_stats {
+  unsigned long long bytes_in;
+  unsigned long long bytes_out;
+  unsigned long long records;
+  unsigned long batches;
+  unsigned long rotations;
+  unsigned long skipped;      /* Log lines, banners and other text */
+  unsigned long bad_frames;   /* Binary units that failed COBS or CRC */
+  unsigned long bad_blocks;   /* Pretty JSON blocks cut short or unbalanced */
+  unsigned long too_long;     /* Lines or frames longer than MAX_UNIT */
+  unsigned long dropped;      /* Records that did not fit in the batch */
+};
+
+static struct ingest_stats stats;
+static volatile sig_atomic_t stop;
+
+/* Input */
+static int in_fd = -1;
+static int in_eof;
+static int binary;
+static uint8_t ring[RING_SIZE];
+static uint32_t ring_head;  /* Bytes read */
+static uint32_t ring_tail;  /* Start of the line or frame being scanned */
+static uint32_t ring_scan;  /* Scanned for its end up to here */
+static int ring_skipping;   /* Dropping the rest of an over-long unit */
+static uint8_t scratch[MAX_UNIT]; /* A unit that wraps around the ring */
+
+/* Pretty JSON block being compacted */
+static char marker[MAX_MARKER];  /* Block name, "" outside a block */
+static int discarding;           /* The block went bad, wait for its end */
+static unsigned depth;
+static int in_string;
+static int escaped;
+
+/* Output batch: whole records up to batch_len, then the object being
+   compacted up to batch_pending; written from batch_out */
+static char batch[BATCH_SIZE];
+static size_t batch_len;
+static size_t batch_pending;
+static size_t batch_out;
+static long long batch_since;
+static size_t batch_threshold = 16 * 1024;
+static long long flush_ms = 1000;
+
+/* Output sink */
+static int out_fd = -1;
+static int out_blocked;  /* The socket took only part of the batch */
+static const char *out_path;
+static const char *sock_path;
+static unsigned long long out_size;
+static unsigned long long rotate_size = 64ULL * 1024 * 1024;
+static unsigned keep_files = 8;
+static long long reconnect_at;
+
+/*---------------------------------------------------------------------------*/
+static long long
+now_ms(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+/*---------------------------------------------------------------------------*/
+/* The poll() timeout: the earlier of \p timeout (-1 for none) and \p at */
+static long long
+wait_until(long long timeout, long long at, long long now)
+{
+  long long left = at > now ? at - now : 0;
+
+  return timeout < 0 || left < timeout ? left : timeout;
+}
+/*---------------------------------------------------------------------------*/
+static void
+on_signal(int sig)
+{
+  (void)sig;
+  stop = 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Output */
+/*---------------------------------------------------------------------------*/
+static int
+open_file(void)
+{
+  struct stat st;
+
+  out_fd = open(out_path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if(out_fd < 0) {
+    perror(out_path);
+    return -1;
+  }
+  out_size = fstat(out_fd, &st) == 0 ? (unsigned long long)st.st_size : 0;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* file.K-1 to file.K, ..., file to file.1 */
+static void
+rotate_file(void)
+{
+  char from[PATH_MAX];
+  char to[PATH_MAX];
+
+  close(out_fd);
+  for(unsigned i = keep_files; i > 1; i--) {
+    snprintf(from, sizeof(from), "%s.%u", out_path, i - 1);
+    snprintf(to, sizeof(to), "%s.%u", out_path, i);
+    rename(from, to);
+  }
+  snprintf(to, sizeof(to), "%s.1", out_path);
+  if(keep_files > 0) {
+    rename(out_path, to);
+  } else {
+    unlink(out_path);
+  }
+  stats.rotations++;
+  if(open_file() < 0) {
+    exit(EXIT_FAILURE);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+connect_socket(void)
+{
+  struct sockaddr_un sa;
+  int fd;
+
+  if(now_ms() < reconnect_at) {
+    return;
+  }
+  reconnect_at = now_ms() + RECONNECT_MS;
+  memset(&sa, 0, sizeof(sa));
+  sa.sun_family = AF_UNIX;
+  strncpy(sa.sun_path, sock_path, sizeof(sa.sun_path) - 1);
+  if((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+    return;
+  }
+  if(connect(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+    close(fd);
+    return;
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  out_fd = fd;
+  /* Whatever was cut off by the last connection goes again in full */
+  while(batch_out > 0 && batch[batch_out - 1] != '\n') {
+    batch_out--;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Write what can be written of the batch without blocking on a socket */
+static void
+flush_batch(void)
+{
+  ssize_t n;
+
+  if(sock_path != NULL && out_fd < 0) {
+    connect_socket();
+  }
+  out_blocked = 0;
+  while(out_fd >= 0 && batch_out < batch_len) {
+    n = write(out_fd, &batch[batch_out], batch_len - batch_out);
+    if(n < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      if(errno == EAGAIN || errno == EWOULDBLOCK) {
+        out_blocked = 1;
+        return;
+      }
+      if(sock_path == NULL) {
+        perror("ber-ingest: write");
+        exit(EXIT_FAILURE);
+      }
+      /* The reader went away */
+      close(out_fd);
+      out_fd = -1;
+      return;
+    }
+    batch_out += n;
+    stats.bytes_out += n;
+    out_size += n;
+  }
+  if(batch_out < batch_len) {
+    return;
+  }
+
+  /* All of it is out: keep the object being compacted, if any */
+  stats.batches++;
+  memmove(batch, &batch[batch_len], batch_pending - batch_len);
+  batch_pending -= batch_len;
+  batch_len = 0;
+  batch_out = 0;
+  if(out_path != NULL && out_size >= rotate_size) {
+    rotate_file();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static size_t
+batch_room(void)
+{
+  return BATCH_SIZE - batch_pending;
+}
+/*---------------------------------------------------------------------------*/
+/* No room for the longest record; the slack covers what a line adds */
+static int
+batch_full(void)
+{
+  return batch_room() <= MAX_UNIT + 64;
+}
+/*---------------------------------------------------------------------------*/
+static void
+batch_append(const char *s, size_t len)
+{
+  memcpy(&batch[batch_pending], s, len);
+  batch_pending += len;
+}
+/*---------------------------------------------------------------------------*/
+/* The record since batch_len is complete */
+static void
+batch_commit(uint8_t count)
+{
+  batch[batch_pending++] = '\n';
+  if(batch_len == 0) {
+    batch_since = now_ms();
+  }
+  batch_len = batch_pending;
+  stats.records += count;
+}
+/*---------------------------------------------------------------------------*/
+/* Pretty JSON, NDJSON and CSV */
+/*---------------------------------------------------------------------------*/
+static void
+block_abort(void)
+{
+  stats.bad_blocks++;
+  batch_pending = batch_len;
+  depth = 0;
+  in_string = 0;
+  escaped = 0;
+}
+/*---------------------------------------------------------------------------*/
+/* "NAME_START" or "NAME_END" with an upper-case NAME */
+static int
+is_marker(const char *s, size_t len, const char *suffix)
+{
+  size_t n = strlen(suffix);
+
+  if(len <= n || len - n >= MAX_MARKER || memcmp(&s[len - n], suffix, n)) {
+    return 0;
+  }
+  for(size_t i = 0; i < len - n; i++) {
+    if(!((s[i] >= 'A' && s[i] <= 'Z') || s[i] == '_')) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* One line of a block: everything outside strings but whitespace, and
+   nothing between the top-level objects ("[", "," and "]" of arrays) */
+static void
+block_line(const char *s, size_t len)
+{
+  char c;
+
+  if(discarding) {
+    return;
+  }
+  if(batch_pending - batch_len > MAX_UNIT) {
+    /* An object that never closes */
+    block_abort();
+    discarding = 1;
+    return;
+  }
+  for(size_t i = 0; i < len; i++) {
+    c = s[i];
+    if(in_string) {
+      batch[batch_pending++] = c;
+      if(escaped) {
+        escaped = 0;
+      } else if(c == '\\') {
+        escaped = 1;
+      } else if(c == '"') {
+        in_string = 0;
+      }
+      continue;
+    }
+    if(c == ' ' || c == '\t') {
+      continue;
+    }
+    if(c == '}' && depth == 0) {
+      block_abort();
+      return;
+    }
+    if(c == '{') {
+      depth++;
+    }
+    if(depth == 0) {
+      continue;
+    }
+    batch[batch_pending++] = c;
+    if(c == '"') {
+      in_string = 1;
+    } else if(c == '}' && --depth == 0) {
+      batch_commit(1);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+text_line(const char *s, size_t len)
+{
+  static const char ping[] = "PING received from: ";
+
+  while(len > 0 && (s[len - 1] == '\r' || s[len - 1] == ' ')) {
+    len--;
+  }
+  while(len > 0 && s[0] == '\r') {
+    s++;
+    len--;
+  }
+
+  if(is_marker(s, len, "_START")) {
+    if(marker[0] != '\0') {
+      /* The end marker of the previous block was lost */
+      block_abort();
+    }
+    memcpy(marker, s, len - 6);
+    marker[len - 6] = '\0';
+    discarding = 0;
+    return;
+  }
+  if(marker[0] != '\0') {
+    if(is_marker(s, len, "_END")) {
+      if(!discarding && (depth > 0 || in_string)) {
+        block_abort();
+      }
+      marker[0] = '\0';
+      discarding = 0;
+      return;
+    }
+    block_line(s, len);
+    return;
+  }
+
+  if(len == 0) {
+    return;
+  }
+  if(s[0] == '{' && s[len - 1] == '}') {
+    /* NDJSON */
+    batch_append(s, len);
+    batch_commit(1);
+    return;
+  }
+  if(len > sizeof(ping) - 1 && !memcmp(s, ping, sizeof(ping) - 1)) {
+    /* Outside a batch, pretty mode has no object for a PING; write what
+       NDJSON would */
+    batch_append("{\"record\":\"ping\",\"ipv6\":\"", 25);
+    batch_append(&s[sizeof(ping) - 1], len - (sizeof(ping) - 1));
+    batch_append("\"}", 2);
+    batch_commit(1);
+    return;
+  }
+  if(!((s[0] >= 'a' && s[0] <= 'z') || s[0] == '#') ||
+     memchr(s, ',', len) == NULL) {
+    /* Log lines and banners; a CSV row starts with its record kind */
+    stats.skipped++;
+    return;
+  }
+  for(size_t i = 0; i < len; i++) {
+    if((unsigned char)s[i] < ' ' || (unsigned char)s[i] > '~') {
+      stats.skipped++;
+      return;
+    }
+  }
+  /* CSV; header rows are not records */
+  batch_append(s, len);
+  batch_commit(s[0] != '#');
+}
+/*---------------------------------------------------------------------------*/
+/* Binary frames */
+/*---------------------------------------------------------------------------*/
+/* As in ber-decode: node ID frames take the address of an earlier frame
+   of the same node that carried it */
+static const char *
+node_addr(const struct ber_frame *f)
+{
+  struct ber_node *n;
+
+  if(f->version == BER_FRAME_VERSION) {
+    return ber_node_addr_str(ber_node_lookup(f->addr));
+  }
+  for(uint8_t i = 0; i < BER_NODE_TABLE_SIZE; i++) {
+    if((n = ber_node_get(i)) != NULL && n->id == f->node_id) {
+      return ber_node_addr_str(n);
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* The line BER_OUTPUT_NDJSON writes for the same record */
+static int
+write_frame(struct ber_json *w, const struct ber_frame *f)
+{
+  const struct ber_payload_type *type = ber_schema_get(f->type);
+  uint32_t present = BER_SCHEMA_ALL_FIELDS;
+  const char *key = "ipv6";
+  const char *value;
+  char kind[MAX_MARKER];
+  char id[8];
+
+  snprintf(id, sizeof(id), "%u", f->node_id);
+  if(type != NULL && type->type == BER_FRAME_TYPE_ANCHOR) {
+    key = "clock";
+    value = ber_time_source_name(f->node_id);
+  } else if(type != NULL && type->type == BER_FRAME_TYPE_PROF) {
+    key = "stage";
+    value = ber_prof_stage_name(f->node_id);
+  } else if((value = node_addr(f)) == NULL) {
+    key = "node_id";
+    value = id;
+  }
+
+  if(f->type == BER_FRAME_TYPE_SUMMARY) {
+    if(f->len == 0 || (type = ber_schema_get(f->payload[0])) == NULL) {
+      return -1;
+    }
+    snprintf(kind, sizeof(kind), "%s_summary", type->name);
+    ber_json_set_style(w, BER_JSON_COMPACT, kind, 0);
+    return ber_summary_write_json(w, f->payload, f->len, key, value,
+                                  f->has_asn ? &f->asn : NULL);
+  }
+
+  if(type == NULL || (type->field_count > 0 && f->len < type->length)) {
+    return -1;
+  }
+  if(type->field_count > 0 &&
+     f->len == type->length + BER_WIRE_MASK_SIZE(type)) {
+    present = 0;
+    for(uint8_t i = 0; i < BER_WIRE_MASK_SIZE(type); i++) {
+      present |= (uint32_t)f->payload[type->length + i] << (8 * i);
+    }
+  }
+  ber_json_set_style(w, BER_JSON_COMPACT, type->name, 0);
+  if(f->has_asn) {
+    ber_schema_write_json_object_at(w, type, f->payload, present, key, value,
+                                    f->asn);
+  } else {
+    ber_schema_write_json_object(w, type, f->payload, present, key, value);
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+frame_unit(const uint8_t *buf, size_t len)
+{
+  struct ber_frame frame;
+  struct ber_json w;
+
+  if(len == 0) {
+    return;
+  }
+  if(len > BER_FRAME_MAX_ENCODED_SIZE ||
+     ber_frame_decode(buf, len, &frame) != 0) {
+    /* Text between frames ends up here too */
+    stats.bad_frames++;
+    return;
+  }
+  /* Room for the newline that batch_commit() adds */
+  ber_json_init(&w, &batch[batch_pending], batch_room() - 1);
+  if(write_frame(&w, &frame) < 0) {
+    stats.bad_frames++;
+    return;
+  }
+  if(ber_json_result(&w) < 0) {
+    stats.dropped++;
+    return;
+  }
+  batch_pending += ber_json_result(&w);
+  batch_commit(1);
+}
+/*---------------------------------------------------------------------------*/
+/* Input */
+/*---------------------------------------------------------------------------*/
+static void
+read_input(void)
+{
+  uint32_t used = ring_head - ring_tail;
+  uint32_t off = ring_head & RING_MASK;
+  struct iovec iov[2];
+  ssize_t n;
+
+  iov[0].iov_base = &ring[off];
+  iov[0].iov_len = RING_SIZE - off < RING_SIZE - used ?
+    RING_SIZE - off : RING_SIZE - used;
+  iov[1].iov_base = ring;
+  iov[1].iov_len = RING_SIZE - used - iov[0].iov_len;
+  n = readv(in_fd, iov, iov[1].iov_len > 0 ? 2 : 1);
+  if(n > 0) {
+    ring_head += n;
+    stats.bytes_in += n;
+  } else if(n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK &&
+                       errno != EINTR)) {
+    /* End of file, or the device or the other end of the pty is gone */
+    in_eof = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Drop the line or frame being scanned, it is longer than MAX_UNIT */
+static void
+skip_unit(void)
+{
+  if(!ring_skipping) {
+    stats.too_long++;
+    if(marker[0] != '\0' && !discarding) {
+      block_abort();
+      discarding = 1;
+    }
+  }
+  ring_skipping = 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Split the ring at line ends, or frame delimiters, while the batch has
+   room for another record */
+static void
+parse_input(void)
+{
+  uint8_t delimiter = binary ? BER_FRAME_DELIMITER : '\n';
+  const uint8_t *unit;
+  const uint8_t *p;
+  uint32_t off;
+  uint32_t len;
+  uint32_t n;
+
+  while(ring_scan != ring_head && !batch_full()) {
+    off = ring_scan & RING_MASK;
+    n = ring_head - ring_scan;
+    if(n > RING_SIZE - off) {
+      n = RING_SIZE - off;
+    }
+    if((p = memchr(&ring[off], delimiter, n)) == NULL) {
+      ring_scan += n;
+      if(ring_scan - ring_tail > MAX_UNIT) {
+        skip_unit();
+        ring_tail = ring_scan;
+      }
+      continue;
+    }
+    ring_scan += p - &ring[off];
+    len = ring_scan - ring_tail;
+    if(len > MAX_UNIT) {
+      skip_unit();
+    }
+    if(!ring_skipping) {
+      off = ring_tail & RING_MASK;
+      if(off + len <= RING_SIZE) {
+        unit = &ring[off];
+      } else {
+        memcpy(scratch, &ring[off], RING_SIZE - off);
+        memcpy(&scratch[RING_SIZE - off], ring, len - (RING_SIZE - off));
+        unit = scratch;
+      }
+      if(binary) {
+        frame_unit(unit, len);
+      } else {
+        text_line((const char *)unit, len);
+      }
+    }
+    ring_skipping = 0;
+    ring_tail = ++ring_scan;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+set_baud(int fd, unsigned long baud)
+{
+  static const struct {
+    unsigned long rate;
+    speed_t speed;
+  } rates[] = {
+    { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 },
+    { 57600, B57600 }, { 115200, B115200 }, { 230400, B230400 },
+    { 460800, B460800 }, { 921600, B921600 },
+  };
+  struct termios tio;
+
+  for(size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+    if(rates[i].rate != baud) {
+      continue;
+    }
+    if(tcgetattr(fd, &tio) < 0) {
+      return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, rates[i].speed);
+    cfsetospeed(&tio, rates[i].speed);
+    return tcsetattr(fd, TCSANOW, &tio);
+  }
+  errno = EINVAL;
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+static double
+cpu_seconds(void)
+{
+  struct rusage ru;
+
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+    (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(double seconds, const struct ingest_stats *since, double cpu)
+{
+  if(seconds <= 0) {
+    seconds = 1e-3;
+  }
+  fprintf(stderr, "ber-ingest: %.0f B/s in, %.1f records/s, %.0f B/s out, "
+          "cpu %.1f%%\n",
+          (stats.bytes_in - since->bytes_in) / seconds,
+          (stats.records - since->records) / seconds,
+          (stats.bytes_out - since->bytes_out) / seconds,
+          100 * cpu / seconds);
+  fprintf(stderr, "ber-ingest: %llu bytes in, %llu records, %llu bytes out "
+          "in %lu batches, %lu rotations; %lu skipped, %lu bad frames, "
+          "%lu bad blocks, %lu too long, %lu dropped\n",
+          stats.bytes_in, stats.records, stats.bytes_out, stats.batches,
+          stats.rotations, stats.skipped, stats.bad_frames, stats.bad_blocks,
+          stats.too_long, stats.dropped);
+}
+/*---------------------------------------------------------------------------*/
+static void
+usage(const char *prog)
+{
+  fprintf(stderr, "Usage: %s [-m text|binary] [-b baud]\n"
+          "       [-o file [-R megabytes] [-k files] | -u socket]\n"
+          "       [-B kilobytes] [-F milliseconds] [-i seconds] [device]\n",
+          prog);
+  exit(EXIT_FAILURE);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  unsigned long baud = 115200;
+  long long interval_ms = 10000;
+  long long started;
+  long long report_at;
+  long long timeout;
+  long long t;
+  double cpu_at;
+  struct ingest_stats last;
+  struct sigaction sa;
+  struct pollfd fds[2];
+  int opt;
+
+  while((opt = getopt(argc, argv, "m:b:o:R:k:u:B:F:i:")) != -1) {
+    switch(opt) {
+    case 'm':
+      if(strcmp(optarg, "binary") == 0) {
+        binary = 1;
+      } else if(strcmp(optarg, "text") != 0) {
+        usage(argv[0]);
+      }
+      break;
+    case 'b':
+      baud = strtoul(optarg, NULL, 0);
+      break;
+    case 'o':
+      out_path = optarg;
+      break;
+    case 'R':
+      rotate_size = strtoull(optarg, NULL, 0) * 1024 * 1024;
+      break;
+    case 'k':
+      keep_files = (unsigned)strtoul(optarg, NULL, 0);
+      break;
+    case 'u':
+      sock_path = optarg;
+      break;
+    case 'B':
+      batch_threshold = strtoul(optarg, NULL, 0) * 1024;
+      break;
+    case 'F':
+      flush_ms = strtoll(optarg, NULL, 0);
+      break;
+    case 'i':
+      interval_ms = strtoll(optarg, NULL, 0) * 1000;
+      break;
+    default:
+      usage(argv[0]);
+    }
+  }
+  if(optind + 1 < argc || (out_path != NULL && sock_path != NULL) ||
+     rotate_size == 0 || batch_threshold == 0 ||
+     batch_threshold > BATCH_SIZE - MAX_UNIT) {
+    usage(argv[0]);
+  }
+
+  in_fd = STDIN_FILENO;
+  if(optind < argc &&
+     (in_fd = open(argv[optind], O_RDONLY | O_NOCTTY)) < 0) {
+    perror(argv[optind]);
+    return EXIT_FAILURE;
+  }
+  if(isatty(in_fd) && set_baud(in_fd, baud) < 0) {
+    perror("ber-ingest: baud rate");
+    return EXIT_FAILURE;
+  }
+  fcntl(in_fd, F_SETFL, fcntl(in_fd, F_GETFL) | O_NONBLOCK);
+
+  if(out_path != NULL) {
+    if(open_file() < 0) {
+      return EXIT_FAILURE;
+    }
+  } else if(sock_path != NULL) {
+    connect_socket();
+  } else {
+    out_fd = STDOUT_FILENO;
+  }
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = on_signal;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  started = now_ms();
+  report_at = started + interval_ms;
+  memset(&last, 0, sizeof(last));
+  cpu_at = 0;
+
+  while(!stop && !(in_eof && ring_scan == ring_head)) {
+    /* Read only while the ring has room, wait for the socket only while
+       it holds up the batch */
+    fds[0].fd = !in_eof && ring_head - ring_tail < RING_SIZE ? in_fd : -1;
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd = out_blocked ? out_fd : -1;
+    fds[1].events = POLLOUT;
+    fds[1].revents = 0;
+
+    /* Wake up for the batch deadline, a reconnect or a report, or right
+       away if the last flush made room for what the ring still holds */
+    t = now_ms();
+    timeout = -1;
+    if(ring_scan != ring_head && !batch_full()) {
+      timeout = 0;
+    }
+    if(batch_len > 0 && !out_blocked && out_fd >= 0) {
+      timeout = wait_until(timeout, batch_since + flush_ms, t);
+    }
+    if(sock_path != NULL && out_fd < 0) {
+      timeout = wait_until(timeout, reconnect_at, t);
+    }
+    if(interval_ms > 0) {
+      timeout = wait_until(timeout, report_at, t);
+    }
+    if(poll(fds, 2, (int)timeout) < 0 && errno != EINTR) {
+      perror("ber-ingest: poll");
+      break;
+    }
+
+    if(fds[0].fd >= 0 && (fds[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+      read_input();
+    }
+    parse_input();
+
+    t = now_ms();
+    if(batch_len > 0 &&
+       (batch_len >= batch_threshold || t - batch_since >= flush_ms ||
+        (out_blocked && (fds[1].revents & (POLLOUT | POLLERR | POLLHUP))) ||
+        batch_full())) {
+      flush_batch();
+    }
+    if(interval_ms > 0 && t >= report_at) {
+      double cpu = cpu_seconds();
+
+      report((t - report_at + interval_ms) / 1000.0, &last, cpu - cpu_at);
+      last = stats;
+      cpu_at = cpu;
+      report_at = t + interval_ms;
+    }
+  }
+
+  /* What is left goes out in full, blocking if need be */
+  if(sock_path != NULL && out_fd < 0) {
+    reconnect_at = 0;
+    connect_socket();
+  }
+  if(out_fd >= 0) {
+    fcntl(out_fd, F_SETFL, fcntl(out_fd, F_GETFL) & ~O_NONBLOCK);
+    flush_batch();
+  }
+  if(batch_len > batch_out) {
+    fprintf(stderr, "ber-ingest: %lu bytes not written\n",
+            (unsigned long)(batch_len - batch_out));
+  }
+  report((now_ms() - started) / 1000.0, &(struct ingest_stats){ 0 },
+         cpu_seconds());
+  return EXIT_SUCCESS;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+#
+# RAM report of a BER firmware build, from the GNU ld map file.
+#
+# Usage: ber-ram.py [-r origin:length] [-n nodes] [-t table] [-s symbol ...]
+#                   map
+#
+# Contiki-NG writes the map next to the firmware, e.g.
+# build/simplelink/launchpad/cc2650/ber.map. The report lists the .data and
+# .bss bytes of every object file in RAM, largest first, followed by the
+# stack and whatever else the linker script reserves, and then works out
+# how many nodes the root could hold: every node costs one BER node table
+# entry and one RPL route (or source-route link), and whatever RAM is left
+# goes to more of them. Non-storing builds give the BER node table a fixed
+# size (-t), and only the source-route links grow with the network.
+#
+# The per-node tables are found by symbol name, so objects must have been
+# built with -fdata-sections, which the ARM targets of Contiki-NG use.
+
+import argparse
+import os
+import re
+import sys
+
+# Tables with one entry per node: the BER node table, and the RPL routes of
+# storing mode or the source-route links of non-storing mode. Their _count
+# arrays (Contiki MEMB) hold one byte per entry, which gives the table size.
+NODE_SYMBOLS = [
+    "nodes",
+    "routememb_memb_mem", "routememb_memb_count",
+    "neighborroutememb_memb_mem", "neighborroutememb_memb_count",
+    "nodememb_memb_mem", "nodememb_memb_count",
+]
+COUNT_SYMBOLS = ["routememb_memb_count", "nodememb_memb_count"]
+
+# The BER node table is indexed with a uint8_t (see ber-node.h)
+BER_NODE_TABLE_MAX = 255
+
+HEX = r"0x([0-9a-fA-F]+)"
+OUTPUT_RE = re.compile(r"^(\S+)(?:\s+" + HEX + r"\s+" + HEX + r")?\s*$")
+INPUT_RE = re.compile(r"^ (\S+)(?:\s+" + HEX + r"\s+" + HEX +
+                      r"(?:\s+(.*))?)?$")
+CONT_RE = re.compile(r"^\s+" + HEX + r"\s+" + HEX + r"(?:\s+(.*))?$")
+REGION_RE = re.compile(r"^(\S+)\s+" + HEX + r"\s+" + HEX + r"(?:\s+(\S+))?")
+
+
+def module_of(obj):
+    """ber-node for build/.../obj/ber-node.o or libfoo.a(ber-node.o)."""
+    m = re.search(r"\(([^)]+)\)$", obj)
+    if m:
+        obj = m.group(1)
+    return re.sub(r"\.o(bj)?$", "", os.path.basename(obj))
+
+
+def symbol_of(section):
+    """nodes for .bss.nodes; None for a plain .bss or COMMON."""
+    for prefix in (".data.", ".bss.", ".sbss.", ".sdata."):
+        if section.startswith(prefix):
+            return section[len(prefix):]
+    return None
+
+
+class MapFile:
+    def __init__(self, path):
+        self.regions = []   # (name, origin, length, attributes)
+        self.outputs = []   # (name, address, size)
+        self.inputs = []    # (output, section, address, size, object)
+        with open(path) as f:
+            self._parse(f.read().splitlines())
+
+    def _parse(self, lines):
+        i = 0
+        while i < len(lines) and not lines[i].startswith("Memory Configuration"):
+            i += 1
+        i += 1
+        while i < len(lines) and not lines[i].startswith("Linker script"):
+            m = REGION_RE.match(lines[i])
+            if m and m.group(1) != "Name":
+                self.regions.append((m.group(1), int(m.group(2), 16),
+                                     int(m.group(3), 16), m.group(4) or ""))
+            i += 1
+
+        output = None
+        pending = None  # Section name whose address is on the next line
+        for line in lines[i:]:
+            if pending is not None:
+                m = CONT_RE.match(line)
+                pending, section = None, pending
+                if m:
+                    self._add(section[0], section[1], m)
+                    continue
+            if not line:
+                continue
+            if line[0] != " ":
+                m = OUTPUT_RE.match(line)
+                if not m:
+                    continue
+                output = m.group(1)
+                if m.group(2) is not None:
+                    self.outputs.append((output, int(m.group(2), 16),
+                                         int(m.group(3), 16)))
+                else:
+                    pending = (None, output)
+                continue
+            m = INPUT_RE.match(line)
+            if not m or line.startswith("  "):
+                continue
+            if m.group(2) is None:
+                pending = (output, m.group(1))
+            else:
+                self.inputs.append((output, m.group(1), int(m.group(2), 16),
+                                    int(m.group(3), 16),
+                                    (m.group(4) or "").strip()))
+
+    def _add(self, output, section, m):
+        address, size = int(m.group(1), 16), int(m.group(2), 16)
+        if output is None:
+            self.outputs.append((section, address, size))
+        else:
+            self.inputs.append((output, section, address, size,
+                                (m.group(3) or "").strip()))
+
+    def ram_region(self):
+        """The writable region that is not the default one."""
+        for name, origin, length, attributes in self.regions:
+            if "w" in attributes.lower() and name != "*default*":
+                return name, origin, length
+        return None
+
+
+def parse_region(text):
+    origin, _, length = text.partition(":")
+    return "RAM", int(origin, 0), int(length, 0)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Per-module RAM use and node capacity of a BER build")
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("-r", "--region", type=parse_region,
+                        help="RAM as origin:length (default: from the map)")
+    parser.add_argument("-n", "--nodes", type=int,
+                        help="node table size of the build (default: from "
+                        "the route table in the map)")
+    parser.add_argument("-t", "--node-table", type=int,
+                        help="BER node table size, when it does not follow "
+                        "the route table (BER_NODE_CONF_TABLE_SIZE)")
+    parser.add_argument("-s", "--symbol", action="append",
+                        help="per-node table symbol (default: the BER node "
+                        "table and the RPL route tables); may be repeated")
+    args = parser.parse_args()
+
+    mapfile = MapFile(args.map)
+    region = args.region or mapfile.ram_region()
+    if region is None:
+        sys.exit("no writable memory region in the map, use -r origin:length")
+    name, origin, length = region
+
+    def in_ram(address, size):
+        return size > 0 and origin <= address < origin + length
+
+    modules = {}
+    symbols = {}
+    claimed = {}
+    for output, section, address, size, obj in mapfile.inputs:
+        if not in_ram(address, size):
+            continue
+        claimed[output] = claimed.get(output, 0) + size
+        if section == "*fill*":
+            key = "(padding)"
+        elif obj:
+            key = module_of(obj)
+        else:
+            key = "(" + output + ")"
+        kind = "data" if output.startswith(".data") else "bss"
+        entry = modules.setdefault(key, {"data": 0, "bss": 0})
+        entry[kind] += size
+        sym = symbol_of(section)
+        if sym is not None:
+            symbols[sym] = symbols.get(sym, 0) + size
+
+    # Output sections the linker script fills itself, like the stack
+    for output, address, size in mapfile.outputs:
+        rest = size - claimed.get(output, 0)
+        if in_ram(address, rest):
+            modules.setdefault("(" + output + ")", {"data": 0, "bss": 0})
+            modules["(" + output + ")"]["bss"] += rest
+
+    used = sum(m["data"] + m["bss"] for m in modules.values())
+    print("RAM region {}: 0x{:08x}, {} bytes".format(name, origin, length))
+    print()
+    print("{:<28} {:>7} {:>7} {:>7}".format("module", "data", "bss", "total"))
+    for key, m in sorted(modules.items(),
+                         key=lambda kv: -(kv[1]["data"] + kv[1]["bss"])):
+        print("{:<28} {:>7} {:>7} {:>7}".format(
+            key, m["data"], m["bss"], m["data"] + m["bss"]))
+    print("{:<28} {:>23}".format("total", used))
+    print("{:<28} {:>23}".format("free", length - used))
+    print()
+
+    nodes = args.nodes
+    if nodes is None:
+        nodes = next((symbols[s] for s in COUNT_SYMBOLS if s in symbols), None)
+    if not nodes:
+        print("Node table size not found in the map, give it with -n")
+        return
+    fixed_table = args.node_table is not None and args.node_table != nodes
+    per_node_symbols = [s for s in (args.symbol or NODE_SYMBOLS)
+                        if s in symbols and not (fixed_table and s == "nodes")]
+    per_node = sum(symbols[s] for s in per_node_symbols) / nodes
+    if per_node == 0:
+        print("No per-node tables found in the map (built without "
+              "-fdata-sections?)")
+        return
+    more = int((length - used) // per_node)
+    print("Per node: {:.0f} bytes ({})".format(
+        per_node, ", ".join("{} {}".format(s, symbols[s])
+                            for s in per_node_symbols)))
+    print("Built for {} nodes; the free RAM holds {} more, {} in total".format(
+        nodes, more, nodes + more))
+    if fixed_table:
+        print("The BER node table has a fixed {} entries; past that the "
+              "least recently heard node is evicted".format(args.node_table))
+    elif nodes + more > BER_NODE_TABLE_MAX:
+        print("The BER node table stops at {}; larger networks evict the "
+              "least recently heard node".format(BER_NODE_TABLE_MAX))
+
+
+if __name__ == "__main__":
+    main()
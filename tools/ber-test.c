@@ -0,0 +1,794 @@
+/*
+ * Copyright (c) 2025, Professor Menachem Moshelion,
+ * Field4D Research Framework, The Hebrew University of Jerusalem, Israel
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+/**
+ * \file
+ *         Regression tests for the BER record pipeline.
+ * \author
+ *         Idan Ifrach <idan.ifrach@mail.huji.ac.il>
+ * \brief
+ *         Feeds hand-built datagrams to ber_record_input() and checks the
+ *         counters and queue it leaves behind. Each test runs on a fresh
+ *         sender address, so tests share the pipeline state but not the
+ *         node entries. Built and run by `make check`; the exit status is
+ *         the number of failed checks.
+ *
+ *         Given a file, the framing test also writes its frames there, for
+ *         make check to count them with ber-decode.
+ *
+ *         Usage: ber-test [frames]
+ */
+#include "ber.h"
+#include "ber-ack.h"
+#include "ber-frame.h"
+#include "ber-node.h"
+#include "ber-queue.h"
+#include "ber-rate.h"
+#include "ber-record.h"
+#include "ber-schema.h"
+#include "ber-summary.h"
+#include "ber-wire.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ENERGEST_LEN 32
+
+static int failures;
+
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if(!(cond)) {                                                       \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__,  \
+              #cond);                                                   \
+      failures++;                                                       \
+    }                                                                   \
+  } while(0)
+
+/* Simulated time: by default a minute per call, which keeps every rate
+   bucket full */
+static uint32_t sim_ms;
+static uint32_t sim_step_ms = 60 * 1000;
+
+/* What the pipeline wrote since the last capture_reset() */
+static char captured[16384];
+static size_t captured_len;
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+sim_clock(void)
+{
+  sim_ms += sim_step_ms;
+  return sim_ms;
+}
+/*---------------------------------------------------------------------------*/
+static void
+capture(const uint8_t *buf, size_t len)
+{
+  if(len > sizeof(captured) - 1 - captured_len) {
+    len = sizeof(captured) - 1 - captured_len;
+  }
+  memcpy(&captured[captured_len], buf, len);
+  captured_len += len;
+  captured[captured_len] = '\0';
+}
+/*---------------------------------------------------------------------------*/
+static void
+capture_reset(void)
+{
+  captured_len = 0;
+  captured[0] = '\0';
+}
+/*---------------------------------------------------------------------------*/
+/* A small JSON syntax check, enough for what the BER writes. Each parse
+   function returns the text after the value, or NULL. */
+static const char *json_value(const char *p);
+
+static const char *
+json_space(const char *p)
+{
+  while(*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+    p++;
+  }
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+static const char *
+json_string(const char *p)
+{
+  if(*p++ != '"') {
+    return NULL;
+  }
+  for(; *p != '"'; p++) {
+    if(*p == '\0' || (unsigned char)*p < 0x20) {
+      return NULL;
+    }
+    if(*p == '\\' && *++p == '\0') {
+      return NULL;
+    }
+  }
+  return p + 1;
+}
+/*---------------------------------------------------------------------------*/
+static const char *
+json_number(const char *p)
+{
+  const char *start;
+
+  if(*p == '-') {
+    p++;
+  }
+  start = p;
+  while(*p >= '0' && *p <= '9') {
+    p++;
+  }
+  if(p == start) {
+    return NULL;
+  }
+  if(*p == '.') {
+    start = ++p;
+    while(*p >= '0' && *p <= '9') {
+      p++;
+    }
+    if(p == start) {
+      return NULL;
+    }
+  }
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+/* An object or array; close is '}' or ']' */
+static const char *
+json_members(const char *p, char close)
+{
+  p = json_space(p + 1);
+  if(*p == close) {
+    return p + 1;
+  }
+  while(1) {
+    if(close == '}') {
+      if((p = json_string(json_space(p))) == NULL) {
+        return NULL;
+      }
+      p = json_space(p);
+      if(*p++ != ':') {
+        return NULL;
+      }
+    }
+    if((p = json_value(p)) == NULL) {
+      return NULL;
+    }
+    p = json_space(p);
+    if(*p == close) {
+      return p + 1;
+    }
+    if(*p++ != ',') {
+      return NULL;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const char *
+json_value(const char *p)
+{
+  p = json_space(p);
+  switch(*p) {
+  case '{':
+    return json_members(p, '}');
+  case '[':
+    return json_members(p, ']');
+  case '"':
+    return json_string(p);
+  case 't':
+    return strncmp(p, "true", 4) == 0 ? p + 4 : NULL;
+  case 'f':
+    return strncmp(p, "false", 5) == 0 ? p + 5 : NULL;
+  case 'n':
+    return strncmp(p, "null", 4) == 0 ? p + 4 : NULL;
+  default:
+    return json_number(p);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Whether the text from start up to end is exactly one JSON value */
+static int
+json_valid(const char *start, const char *end)
+{
+  const char *p = json_value(start);
+
+  if(p == NULL || p > end) {
+    return 0;
+  }
+  while(p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+    p++;
+  }
+  return p == end;
+}
+/*---------------------------------------------------------------------------*/
+static void
+make_addr(uint8_t *addr, uint8_t id)
+{
+  memset(addr, 0, BER_FRAME_ADDR_SIZE);
+  addr[0] = 0xfd;
+  addr[15] = id;
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_varint(uint8_t **p, int32_t v)
+{
+  uint32_t u = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+
+  while(u >= 0x80) {
+    *(*p)++ = (u & 0x7f) | 0x80;
+    u >>= 7;
+  }
+  *(*p)++ = u;
+}
+/*---------------------------------------------------------------------------*/
+/* A varint IMF4D record with every field present: field i holds values[i],
+   package_number holds seq. Returns the datagram length. */
+static uint16_t
+make_varint_imf4d(uint8_t *buf, const int32_t *values, uint32_t seq)
+{
+  const struct ber_payload_type *type = ber_schema_get(BER_FRAME_TYPE_IMF4D);
+  uint8_t *p = &buf[BER_WIRE_HEADER_SIZE];
+  uint32_t mask = (1UL << type->field_count) - 1;
+  uint8_t i;
+
+  for(i = 0; i < BER_WIRE_MASK_SIZE(type); i++) {
+    *p++ = mask >> (8 * i);
+  }
+  for(i = 0; i < type->field_count; i++) {
+    put_varint(&p, i == type->seq_field ? (int32_t)seq : values[i]);
+  }
+  buf[0] = BER_WIRE_MAGIC;
+  buf[1] = BER_WIRE_VERSION_TYPE(BER_WIRE_VERSION_VARINT, type->type);
+  buf[2] = (p - buf) - BER_WIRE_HEADER_SIZE;
+  return p - buf;
+}
+/*---------------------------------------------------------------------------*/
+static void
+drain(void)
+{
+  while(ber_queue_peek() != NULL) {
+    ber_queue_pop();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+get_le32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+    ((uint32_t)p[3] << 24);
+}
+/*---------------------------------------------------------------------------*/
+/* A headered record that happens to be as long as an energest report is
+   still a record */
+static void
+test_headered_energest_length(void)
+{
+  /* A 4-byte, a 3-byte and two 2-byte varints take the 25 bytes of
+     one-byte fields to 32 */
+  static const int32_t values[] = { 100000000, 2500, 1000000, 100 };
+  int32_t all[BER_FRAME_MAX_PAYLOAD / 4] = { 0 };
+  struct ber_record_stats before = *ber_record_get_stats();
+  const struct ber_record_stats *after;
+  uint8_t buf[BER_FRAME_MAX_PAYLOAD];
+  uint8_t addr[BER_FRAME_ADDR_SIZE];
+  uint16_t len;
+
+  memcpy(all, values, sizeof(values));
+  make_addr(addr, 1);
+  len = make_varint_imf4d(buf, all, 7);
+  CHECK(len == ENERGEST_LEN);
+
+  ber_record_input(addr, buf, len);
+  after = ber_record_get_stats();
+  CHECK(after->energest == before.energest);
+  CHECK(after->versioned == before.versioned + 1);
+  CHECK(after->by_type[BER_FRAME_TYPE_IMF4D] ==
+        before.by_type[BER_FRAME_TYPE_IMF4D] + 1);
+#if !BER_SUMMARY
+  /* With the summary on, the record waits for the end of its window */
+  CHECK(ber_queue_count() == 1);
+  CHECK(ber_queue_peek() != NULL &&
+        ber_queue_peek()->type == BER_FRAME_TYPE_IMF4D);
+#endif
+  CHECK(ber_rate_class(buf, len) == BER_RATE_DATA);
+  drain();
+}
+/*---------------------------------------------------------------------------*/
+/* Writing a record must not take a table entry from a node still sending */
+static void
+test_output_keeps_nodes(void)
+{
+  static const int32_t values[BER_FRAME_MAX_PAYLOAD / 4] = { 0 };
+  uint8_t buf[BER_FRAME_MAX_PAYLOAD];
+  uint8_t addr[BER_FRAME_ADDR_SIZE];
+  struct ber_record r;
+  uint16_t len;
+  uint8_t i;
+
+  /* Fill the table */
+  for(i = 0; i < BER_NODE_TABLE_SIZE; i++) {
+    make_addr(addr, 100 + i);
+    len = make_varint_imf4d(buf, values, 1);
+    ber_record_input(addr, buf, len);
+    drain();
+  }
+  CHECK(ber_node_count() == BER_NODE_TABLE_SIZE);
+
+  /* A record of a node that is not in the table, as replayed from flash */
+  memset(&r, 0, sizeof(r));
+  make_addr(r.addr, 99);
+  r.type = BER_FRAME_TYPE_IMF4D;
+  r.len = ber_schema_get(BER_FRAME_TYPE_IMF4D)->length;
+  r.present = BER_SCHEMA_ALL_FIELDS;
+  ber_record_output(&r, 0);
+  ber_record_stored(&r, 0, 0);
+
+  CHECK(ber_node_find(r.addr) == NULL);
+  for(i = 0; i < BER_NODE_TABLE_SIZE; i++) {
+    make_addr(addr, 100 + i);
+    CHECK(ber_node_find(addr) != NULL && ber_node_find(addr)->has_seq);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* With the summary on, records skip the queue */
+#if !BER_SUMMARY
+/* A record dropped on a full queue must not be ACKed, so that the node
+   sends it again and the copy is not taken for a duplicate */
+static void
+test_overflow_ack(void)
+{
+  static const int32_t values[BER_FRAME_MAX_PAYLOAD / 4] = { 0 };
+  uint8_t buf[BER_FRAME_MAX_PAYLOAD];
+  uint8_t addr[BER_FRAME_ADDR_SIZE];
+  uint8_t ack[BER_ACK_HEADER_SIZE + BER_ACK_ENTRY_SIZE];
+  const uint8_t *entry = &ack[BER_ACK_HEADER_SIZE];
+  uint32_t overflow = BER_QUEUE_SIZE + 1;
+  struct ber_node *node;
+  uint16_t len;
+  uint32_t seq;
+  int queued;
+
+  make_addr(addr, 2);
+  drain();
+  for(seq = 1; seq <= overflow; seq++) {
+    len = make_varint_imf4d(buf, values, seq);
+    queued = ber_record_input(addr, buf, len);
+    CHECK(queued == (BER_QUEUE_DROP_OLDEST || seq < overflow));
+  }
+  node = ber_node_find(addr);
+  CHECK(node != NULL);
+  if(node == NULL) {
+    return;
+  }
+  CHECK(ber_ack_build_node(ack, sizeof(ack), node) == sizeof(ack));
+#if BER_QUEUE_DROP_OLDEST
+  /* Seq 1 was overwritten by seq 9 */
+  CHECK(get_le32(&entry[2]) == overflow);
+  CHECK(get_le32(&entry[6]) == (1UL << BER_QUEUE_SIZE) - 1);
+  seq = 1;
+#else
+  /* Seq 9 was dropped */
+  CHECK(get_le32(&entry[2]) == overflow - 1);
+  CHECK(get_le32(&entry[6]) == (1UL << BER_QUEUE_SIZE) - 1);
+  seq = overflow;
+#endif
+
+  /* The retransmit of the lost record is queued, and then ACKed */
+  drain();
+  len = make_varint_imf4d(buf, values, seq);
+  CHECK(ber_record_input(addr, buf, len) == 1);
+  CHECK(ber_ack_build_node(ack, sizeof(ack), node) == sizeof(ack));
+  CHECK(get_le32(&entry[2]) == overflow);
+  CHECK(get_le32(&entry[6]) == (1UL << overflow) - 1);
+
+  /* And a second copy is a duplicate */
+  ber_record_input(addr, buf, len);
+  CHECK(node->seq.duplicates == 1);
+  drain();
+}
+#endif
+/*---------------------------------------------------------------------------*/
+/* Decode a frame built by ber_frame_encode(), without its delimiters, and
+   compare it with what was sent */
+static int
+frame_round_trip(const uint8_t *out, size_t n, const uint8_t *addr,
+                 const uint8_t *payload, uint8_t len)
+{
+  struct ber_frame frame;
+
+  return n > 2 && out[0] == BER_FRAME_DELIMITER &&
+    out[n - 1] == BER_FRAME_DELIMITER &&
+    memchr(&out[1], BER_FRAME_DELIMITER, n - 2) == NULL &&
+    ber_frame_decode(&out[1], n - 2, &frame) == 0 &&
+    frame.type == BER_FRAME_TYPE_IMF4D && frame.len == len &&
+    !memcmp(frame.addr, addr, BER_FRAME_ADDR_SIZE) &&
+    !memcmp(frame.payload, payload, len);
+}
+/*---------------------------------------------------------------------------*/
+/* COBS and CRC framing: zero bytes and a run of non-zero bytes longer than
+   a COBS block come back as they were sent, a frame that fails its CRC is
+   rejected. The frames also go to \p stream if it is not NULL. */
+static void
+test_frame(FILE *stream)
+{
+  uint8_t payload[BER_FRAME_MAX_PAYLOAD];
+  uint8_t out[BER_FRAME_MAX_ENCODED_SIZE];
+  uint8_t bad[BER_FRAME_MAX_ENCODED_SIZE];
+  uint8_t addr[BER_FRAME_ADDR_SIZE];
+  struct ber_frame frame;
+  size_t n;
+  size_t i;
+
+  /* Zeros at both ends of the payload and in between */
+  make_addr(addr, 70);
+  for(i = 0; i < 40; i++) {
+    payload[i] = i % 3 == 0 ? 0 : i;
+  }
+  payload[39] = 0;
+  n = ber_frame_encode(out, sizeof(out), BER_FRAME_TYPE_IMF4D, addr,
+                       payload, 40);
+  CHECK(frame_round_trip(out, n, addr, payload, 40));
+  if(stream != NULL) {
+    fwrite(out, 1, n, stream);
+  }
+
+  /* No zero from the version byte to the end of the payload */
+  memset(addr, 0xfd, sizeof(addr));
+  memset(payload, 0x55, sizeof(payload));
+  n = ber_frame_encode(out, sizeof(out), BER_FRAME_TYPE_IMF4D, addr,
+                       payload, BER_FRAME_MAX_PAYLOAD);
+  CHECK(frame_round_trip(out, n, addr, payload, BER_FRAME_MAX_PAYLOAD));
+#if BER_FRAME_HEADER_SIZE + BER_FRAME_MAX_PAYLOAD >= 254
+  /* The run fills a whole COBS block */
+  CHECK(out[1] == 0xff);
+#endif
+
+  /* One payload bit flipped: still valid COBS, but the CRC fails */
+  memcpy(bad, out, n);
+  bad[n / 2] ^= 0x01;
+  CHECK(bad[n / 2] != BER_FRAME_DELIMITER);
+  CHECK(ber_frame_decode(&bad[1], n - 2, &frame) == -1);
+  if(stream != NULL) {
+    fwrite(bad, 1, n, stream);
+    fwrite(out, 1, n, stream);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* A PING between two records of a JSON batch is an element of the array */
+static void
+test_batch_ping(void)
+{
+  const struct ber_payload_type *imf4d = ber_schema_get(BER_FRAME_TYPE_IMF4D);
+  static const uint8_t record[BER_QUEUE_RECORD_SIZE] = { 0 };
+  uint8_t addr[BER_FRAME_ADDR_SIZE];
+  struct ber_record *r;
+  const char *start;
+  const char *end;
+
+  /* Queued directly: with the summary on, input would keep the records */
+  make_addr(addr, 3);
+  drain();
+  CHECK(ber_queue_put(addr, BER_FRAME_TYPE_IMF4D, BER_SCHEMA_ALL_FIELDS,
+                      record, imf4d->length));
+  CHECK(ber_queue_put(addr, BER_FRAME_TYPE_PING, BER_SCHEMA_ALL_FIELDS,
+                      record, 2));
+  CHECK(ber_queue_put(addr, BER_FRAME_TYPE_IMF4D, BER_SCHEMA_ALL_FIELDS,
+                      record, imf4d->length));
+
+  ber_set_output_mode(BER_OUTPUT_JSON);
+  capture_reset();
+  ber_record_batch_begin(ber_queue_count());
+  while((r = ber_queue_peek()) != NULL) {
+    ber_record_output(r, 1);
+    ber_queue_pop();
+  }
+  ber_record_batch_end();
+
+  start = strstr(captured, "JSON_BATCH_START\n");
+  end = strstr(captured, "\nJSON_BATCH_END\n");
+  CHECK(start != NULL && end != NULL && start < end);
+  if(start != NULL && end != NULL && start < end) {
+    start += strlen("JSON_BATCH_START\n");
+    CHECK(json_valid(start, end));
+    CHECK(strstr(start, "\"record\":\"ping\"") != NULL);
+  }
+
+  /* An empty batch writes nothing */
+  capture_reset();
+  ber_record_batch_begin(0);
+  ber_record_batch_end();
+  CHECK(captured_len == 0);
+}
+/*---------------------------------------------------------------------------*/
+/* A node flooding the BER is rate limited; one sending at its normal rate
+   next to it loses nothing */
+static void
+test_rate_flood(void)
+{
+#if BER_RATE
+  static const int32_t values[BER_FRAME_MAX_PAYLOAD / 4] = { 0 };
+  uint32_t limited = ber_record_get_stats()->rate_limited[BER_RATE_DATA];
+  uint8_t buf[BER_FRAME_MAX_PAYLOAD];
+  uint8_t flooder[BER_FRAME_ADDR_SIZE];
+  uint8_t regular[BER_FRAME_ADDR_SIZE];
+  struct ber_node *f;
+  struct ber_node *n;
+  uint32_t seq = 1;
+  uint16_t len;
+  int minute;
+  int i;
+
+  make_addr(flooder, 4);
+  make_addr(regular, 5);
+  drain();
+  sim_step_ms = 0;
+  for(minute = 0; minute < 10; minute++) {
+    sim_ms += 60 * 1000;
+    len = make_varint_imf4d(buf, values, minute + 1);
+    ber_record_input(regular, buf, len);
+    drain();
+    for(i = 0; i < 20; i++) {
+      len = make_varint_imf4d(buf, values, seq++);
+      ber_record_input(flooder, buf, len);
+      drain();
+    }
+  }
+  sim_step_ms = 60 * 1000;
+
+  f = ber_node_find(flooder);
+  n = ber_node_find(regular);
+  CHECK(f != NULL && n != NULL);
+  if(f == NULL || n == NULL) {
+    return;
+  }
+  /* A minute refills the bucket, up to its burst */
+  CHECK(f->seq.rate_limited > 0);
+  CHECK(f->seq.rate_limited <= 200 - 10 *
+        (BER_RATE_DATA_BURST < BER_RATE_DATA_PER_MINUTE ?
+         BER_RATE_DATA_BURST : BER_RATE_DATA_PER_MINUTE));
+  CHECK(ber_record_get_stats()->rate_limited[BER_RATE_DATA] - limited ==
+        f->seq.rate_limited);
+  CHECK(n->seq.rate_limited == 0);
+  CHECK(n->seq.received == 10);
+#endif
+}
+#if BER_SUMMARY
+/*---------------------------------------------------------------------------*/
+static const struct ber_field *
+field_named(const struct ber_payload_type *type, const char *name)
+{
+  for(uint8_t i = 0; i < type->field_count; i++) {
+    if(!strcmp(type->fields[i].name, name)) {
+      return &type->fields[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_le32(uint8_t *p, int32_t v)
+{
+  uint32_t u = (uint32_t)v;
+
+  p[0] = u;
+  p[1] = u >> 8;
+  p[2] = u >> 16;
+  p[3] = u >> 24;
+}
+/*---------------------------------------------------------------------------*/
+/* Set a field of a record; a split field takes its integer part and
+   fraction as separate words */
+static void
+set_field(const struct ber_payload_type *type, uint8_t *data,
+          const char *name, int32_t ipart, int32_t frac)
+{
+  const struct ber_field *f = field_named(type, name);
+
+  put_le32(&data[f->offset], ipart);
+  if(f->kind == BER_FIELD_SPLIT) {
+    put_le32(&data[f->offset + 4], frac);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const struct ber_summary *
+find_summary(const uint8_t *addr, uint8_t type)
+{
+  const struct ber_summary *s;
+
+  for(uint8_t i = 0; i < BER_SUMMARY_SLOTS; i++) {
+    s = ber_summary_get(i);
+    if(s != NULL && s->type == type &&
+       !memcmp(s->addr, addr, BER_FRAME_ADDR_SIZE)) {
+      return s;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Word `word` of a field in the payload of one statistic */
+static int32_t
+stat_word(const struct ber_summary *s, uint8_t stat, const char *name,
+          uint8_t word)
+{
+  const struct ber_payload_type *type = ber_schema_get(s->type);
+  uint8_t payload[BER_SUMMARY_HEADER_SIZE + BER_FRAME_MAX_PAYLOAD + 4];
+
+  ber_summary_payload(s, stat, payload);
+  return (int32_t)get_le32(&payload[BER_SUMMARY_HEADER_SIZE +
+                                    field_named(type, name)->offset +
+                                    4 * word]);
+}
+/*---------------------------------------------------------------------------*/
+/* Known values through the window: min, max, the rounded mean and the
+   population sd, for plain and split fields of either sign. The
+   package_number is not summarized. */
+static void
+test_summary(void)
+{
+  static const int32_t rssi[] = { -70, -72, -75 };
+  static const int32_t temp[] = { 1, 2, 2 };
+  const struct ber_payload_type *imf4d = ber_schema_get(BER_FRAME_TYPE_IMF4D);
+  const struct ber_payload_type *legacy =
+    ber_schema_get(BER_FRAME_TYPE_LEGACY);
+  uint8_t payload[BER_SUMMARY_HEADER_SIZE + BER_FRAME_MAX_PAYLOAD + 4];
+  uint8_t data[BER_FRAME_MAX_PAYLOAD];
+  uint8_t addr[BER_FRAME_ADDR_SIZE];
+  const struct ber_summary *s;
+  uint8_t len;
+  uint8_t i;
+
+  /* The earlier tests have filled windows of their own */
+  for(i = 0; i < BER_SUMMARY_SLOTS; i++) {
+    ber_summary_clear(i);
+  }
+
+  make_addr(addr, 60);
+  for(i = 0; i < 3; i++) {
+    memset(data, 0, sizeof(data));
+    set_field(imf4d, data, "rssi", rssi[i], 0);
+    set_field(imf4d, data, "hdc_2010_u13_temperature", temp[i], 0);
+    set_field(imf4d, data, "hdc_2010_u13_humidity", -temp[i], 0);
+    set_field(imf4d, data, "package_number", 100 + i, 0);
+    CHECK(ber_summary_add(addr, imf4d, data,
+                          (1UL << imf4d->field_count) - 1) == 0);
+  }
+  s = find_summary(addr, BER_FRAME_TYPE_IMF4D);
+  CHECK(s != NULL);
+  if(s == NULL) {
+    return;
+  }
+  CHECK(s->records == 3);
+  CHECK(stat_word(s, BER_SUMMARY_MIN, "rssi", 0) == -75);
+  CHECK(stat_word(s, BER_SUMMARY_MAX, "rssi", 0) == -70);
+  CHECK(stat_word(s, BER_SUMMARY_MEAN, "rssi", 0) == -72); /* -72.33 */
+  CHECK(stat_word(s, BER_SUMMARY_SD, "rssi", 0) == 2);     /* 2.05 */
+  /* 1.67 and -1.67 round away from the first value */
+  CHECK(stat_word(s, BER_SUMMARY_MEAN, "hdc_2010_u13_temperature", 0) == 2);
+  CHECK(stat_word(s, BER_SUMMARY_MEAN, "hdc_2010_u13_humidity", 0) == -2);
+  CHECK(stat_word(s, BER_SUMMARY_SD, "hdc_2010_u13_humidity", 0) == 0);
+
+  /* The package_number is left out of the presence bitmap */
+  len = ber_summary_payload(s, BER_SUMMARY_MEAN, payload);
+  CHECK(len == BER_SUMMARY_HEADER_SIZE + imf4d->length +
+        BER_WIRE_MASK_SIZE(imf4d));
+  CHECK(!(get_le32(&payload[BER_SUMMARY_HEADER_SIZE + imf4d->length]) &
+          (1UL << imf4d->seq_field)));
+  CHECK(stat_word(s, BER_SUMMARY_MAX, "package_number", 0) == 0);
+
+  /* Split fields: -0.50 and 1.25, then -2.05 and -1.00 */
+  make_addr(addr, 61);
+  memset(data, 0, sizeof(data));
+  set_field(legacy, data, "light", 0, -50);
+  set_field(legacy, data, "bmp_temp", -2, 5);
+  CHECK(ber_summary_add(addr, legacy, data, BER_SCHEMA_ALL_FIELDS) == 0);
+  set_field(legacy, data, "light", 1, 25);
+  set_field(legacy, data, "bmp_temp", -1, 0);
+  CHECK(ber_summary_add(addr, legacy, data, BER_SCHEMA_ALL_FIELDS) == 0);
+  s = find_summary(addr, BER_FRAME_TYPE_LEGACY);
+  CHECK(s != NULL);
+  if(s == NULL) {
+    return;
+  }
+  CHECK(stat_word(s, BER_SUMMARY_MIN, "light", 0) == 0);
+  CHECK(stat_word(s, BER_SUMMARY_MIN, "light", 1) == -50);
+  CHECK(stat_word(s, BER_SUMMARY_MAX, "light", 0) == 1);
+  CHECK(stat_word(s, BER_SUMMARY_MAX, "light", 1) == 25);
+  CHECK(stat_word(s, BER_SUMMARY_MEAN, "light", 0) == 0);  /* 0.375 */
+  CHECK(stat_word(s, BER_SUMMARY_MEAN, "light", 1) == 38);
+  CHECK(stat_word(s, BER_SUMMARY_SD, "light", 0) == 0);    /* 0.875 */
+  CHECK(stat_word(s, BER_SUMMARY_SD, "light", 1) == 87);
+  CHECK(stat_word(s, BER_SUMMARY_MIN, "bmp_temp", 0) == -2);
+  CHECK(stat_word(s, BER_SUMMARY_MIN, "bmp_temp", 1) == -5);
+  CHECK(stat_word(s, BER_SUMMARY_MAX, "bmp_temp", 0) == -1);
+  CHECK(stat_word(s, BER_SUMMARY_MAX, "bmp_temp", 1) == 0);
+  CHECK(stat_word(s, BER_SUMMARY_MEAN, "bmp_temp", 0) == -1); /* -1.525 */
+  CHECK(stat_word(s, BER_SUMMARY_MEAN, "bmp_temp", 1) == -52);
+  CHECK(stat_word(s, BER_SUMMARY_SD, "bmp_temp", 0) == 0);    /* 0.525 */
+  CHECK(stat_word(s, BER_SUMMARY_SD, "bmp_temp", 1) == 52);
+
+#ifdef BER_SUMMARY_CONF_THRESHOLDS
+  /* make check sets an rssi range of -90 to -30: outside it the record
+     also goes out raw, and is summarized all the same */
+  make_addr(addr, 62);
+  memset(data, 0, sizeof(data));
+  set_field(imf4d, data, "rssi", -50, 0);
+  CHECK(ber_summary_add(addr, imf4d, data, BER_SCHEMA_ALL_FIELDS) == 0);
+  set_field(imf4d, data, "rssi", -95, 0);
+  CHECK(ber_summary_add(addr, imf4d, data, BER_SCHEMA_ALL_FIELDS) == 1);
+  s = find_summary(addr, BER_FRAME_TYPE_IMF4D);
+  CHECK(s != NULL && s->records == 2);
+#endif
+
+  for(i = 0; i < BER_SUMMARY_SLOTS; i++) {
+    ber_summary_clear(i);
+  }
+}
+#endif /* BER_SUMMARY */
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  FILE *frames = NULL;
+
+  if(argc > 1 && (frames = fopen(argv[1], "wb")) == NULL) {
+    perror(argv[1]);
+    return EXIT_FAILURE;
+  }
+  ber_record_set_writer(capture);
+  ber_record_set_verbose(0);
+  ber_rate_set_clock(sim_clock);
+
+  test_headered_energest_length();
+  test_output_keeps_nodes();
+#if !BER_SUMMARY
+  test_overflow_ack();
+#endif
+  test_frame(frames);
+  test_batch_ping();
+  test_rate_flood();
+#if BER_SUMMARY
+  test_summary();
+#endif
+
+  if(frames != NULL) {
+    fclose(frames);
+  }
+  if(failures > 0) {
+    fprintf(stderr, "%d check(s) failed\n", failures);
+  } else {
+    fprintf(stderr, "all checks passed\n");
+  }
+  return failures;
+}
+/*---------------------------------------------------------------------------*/